@@ -0,0 +1,107 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// Micro-benchmark for gzip compression with [GZipCodec], on one thread and
+/// with parallel compression of blocks.
+
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+const numBytesToEncode = 8 * 1024 * 1024; // Compress 8MiB in all benchmarks.
+
+/// Compressible input resembling log lines.
+Uint8List makeInput() {
+  final random = Random(42);
+  final words =
+      'GET POST /api/v1/items /static/app.js 200 404 OK user session '
+              'latency_ms INFO WARN request response'
+          .split(' ');
+  final builder = BytesBuilder(copy: false);
+  var length = 0;
+  var line = 0;
+  while (length < numBytesToEncode) {
+    final text = StringBuffer('${line++} ');
+    for (var i = 0; i < 12; i++) {
+      text
+        ..write(words[random.nextInt(words.length)])
+        ..write(i.isEven ? ' ' : '=${random.nextInt(100000)} ');
+    }
+    text.write('\n');
+    final bytes = text.toString().codeUnits;
+    builder.add(bytes);
+    length += bytes.length;
+  }
+  return Uint8List.sublistView(builder.takeBytes(), 0, numBytesToEncode);
+}
+
+/// Benchmark compressing [numBytesToEncode] bytes with a single call to
+/// [GZipCodec.encode].
+class BenchmarkEncode extends BenchmarkBase {
+  final GZipCodec _codec;
+  late final Uint8List _input;
+
+  BenchmarkEncode(int threads)
+    : _codec = GZipCodec(threads: threads),
+      super('GZipEncode.Encode.Threads$threads');
+
+  @override
+  void setup() {
+    _input = makeInput();
+  }
+
+  @override
+  void run() {
+    _codec.encode(_input);
+  }
+}
+
+/// Benchmark compressing [numBytesToEncode] bytes added in 64KiB chunks, as
+/// when streaming a response body.
+class BenchmarkChunked extends BenchmarkBase {
+  final GZipCodec _codec;
+  late final Uint8List _input;
+
+  BenchmarkChunked(int threads)
+    : _codec = GZipCodec(threads: threads),
+      super('GZipEncode.Chunked.Threads$threads');
+
+  @override
+  void setup() {
+    _input = makeInput();
+  }
+
+  @override
+  void run() {
+    final sink = _codec.encoder.startChunkedConversion(_NullSink());
+    const chunkSize = 64 * 1024;
+    for (var i = 0; i < _input.length; i += chunkSize) {
+      sink.addSlice(_input, i, min(i + chunkSize, _input.length), false);
+    }
+    sink.close();
+  }
+}
+
+class _NullSink implements Sink<List<int>> {
+  @override
+  void add(List<int> data) {}
+
+  @override
+  void close() {}
+}
+
+void main() {
+  final benchmarks = [
+    BenchmarkEncode(1),
+    BenchmarkEncode(4),
+    BenchmarkChunked(1),
+    BenchmarkChunked(4),
+  ];
+
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+  }
+}
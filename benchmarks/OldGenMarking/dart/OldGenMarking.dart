@@ -0,0 +1,61 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures old-space collections of a large, pointer-heavy live heap, which
+// are dominated by marking. Compare runs with and without the VM flag
+// --transparent_huge_pages to see the effect of TLB misses while marking.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+class Node {
+  Node? next;
+  final List<Object?> edges;
+
+  Node(this.next, int fanOut) : edges = List<Object?>.filled(fanOut, null);
+}
+
+class OldGenMarking extends BenchmarkBase {
+  OldGenMarking() : super('OldGenMarking');
+
+  static const int liveNodes = 1 << 20;
+  static const int fanOut = 4;
+
+  final List<Node> live = <Node>[];
+
+  @override
+  void setup() {
+    // Link nodes in a scattered order so the marker's accesses are spread over
+    // the whole heap.
+    Node? previous;
+    for (int i = 0; i < liveNodes; i++) {
+      final node = Node(previous, fanOut);
+      live.add(node);
+      previous = node;
+    }
+    for (int i = 0; i < liveNodes; i++) {
+      final edges = live[i].edges;
+      for (int j = 0; j < fanOut; j++) {
+        edges[j] = live[(i * 7919 + j * 104729) % liveNodes];
+      }
+    }
+  }
+
+  @override
+  void run() {
+    // Arrays this large are allocated directly in old space, so allocating
+    // them repeatedly triggers old-space collections that mark the live graph.
+    for (int i = 0; i < 64; i++) {
+      List<Object?>.filled(1 << 17, i);
+    }
+  }
+
+  @override
+  void teardown() {
+    live.clear();
+  }
+}
+
+void main() {
+  OldGenMarking().report();
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures scavenges that promote large, wide object graphs. Compare runs with
+// the VM flags --no-scavenger_work_stealing and --scavenger_tasks=<n> to see
+// how parallel scavenger workers share the promotion work.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+class Node {
+  final Node? left;
+  final Node? right;
+  final List<int> payload;
+
+  Node(this.left, this.right) : payload = List<int>.filled(4, 0);
+}
+
+Node? buildTree(int depth) {
+  if (depth == 0) return null;
+  return Node(buildTree(depth - 1), buildTree(depth - 1));
+}
+
+class ScavengePromotion extends BenchmarkBase {
+  ScavengePromotion() : super('ScavengePromotion');
+
+  // A rolling window of trees; each tree stays reachable long enough to
+  // survive two scavenges and be promoted.
+  final List<Node?> live = List<Node?>.filled(16, null);
+  int next = 0;
+
+  @override
+  void run() {
+    for (int i = 0; i < live.length; i++) {
+      live[next] = buildTree(12);
+      next = (next + 1) % live.length;
+    }
+  }
+
+  @override
+  void teardown() {
+    live.fillRange(0, live.length, null);
+  }
+}
+
+void main() {
+  ScavengePromotion().report();
+}
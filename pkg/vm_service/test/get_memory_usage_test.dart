@@ -14,6 +14,11 @@ final tests = <VMTest>[
     expect(result.heapUsage, isPositive);
     expect(result.heapCapacity, isPositive);
     expect(result.externalUsage, greaterThanOrEqualTo(0));
+    expect(result.json!['_oldSpacePhase'], isA<String>());
+    expect(result.json!['_sweptPages'], greaterThanOrEqualTo(0));
+    expect(result.json!['_unsweptPages'], greaterThanOrEqualTo(0));
+    expect(result.json!['_sweptLargePages'], greaterThanOrEqualTo(0));
+    expect(result.json!['_unsweptLargePages'], greaterThanOrEqualTo(0));
   },
   (VmService service) async {
     bool? caughtException;
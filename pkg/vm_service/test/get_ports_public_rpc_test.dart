@@ -12,6 +12,7 @@ import 'common/test_helper.dart';
 late final RawReceivePort port1;
 late final RawReceivePort port2;
 late final RawReceivePort port3;
+late final RawReceivePort port5;
 
 void warmup() {
   port1 = RawReceivePort(null, 'port1');
@@ -19,6 +20,7 @@ void warmup() {
   port3 = RawReceivePort((_) {}, 'port3');
   port3.close();
   RawReceivePort((_) {}, 'port4');
+  port5 = RawReceivePort.bounded(4, handler: (_) {}, debugName: 'port5');
 }
 
 int countNameMatches(List<InstanceRef> ports, String name) {
@@ -44,6 +46,17 @@ final tests = <IsolateTest>[
     expect(countNameMatches(ports, 'port3'), 0);
     expect(countNameMatches(ports, 'port4'), 1);
     expect(countNameMatches(ports, ''), greaterThanOrEqualTo(1));
+
+    // Ports report how many messages wait for them, and bounded ports how
+    // many may.
+    for (final port in ports) {
+      expect(port.json!['_queueDepth'], isA<int>());
+      if (port.debugName == 'port5') {
+        expect(port.json!['_capacity'], 4);
+      } else {
+        expect(port.json!['_capacity'], isNull);
+      }
+    }
   },
 ];
 
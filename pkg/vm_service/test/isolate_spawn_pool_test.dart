@@ -0,0 +1,77 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:developer';
+// ignore: library_prefixes
+import 'dart:isolate' as I;
+
+import 'package:test/test.dart';
+import 'package:vm_service/vm_service.dart';
+
+import 'common/service_test_common.dart';
+import 'common/test_helper.dart';
+
+// AUTOGENERATED START
+//
+// Update these constants by running:
+//
+// dart pkg/vm_service/test/update_line_numbers.dart pkg/vm_service/test/isolate_spawn_pool_test.dart
+//
+const LINE_A = 32;
+// AUTOGENERATED END
+
+const poolSize = 2;
+
+void child(_) {}
+
+Future<void> during() async {
+  // The pool is filled after the first spawn in the group.
+  await I.Isolate.run(() => null);
+  debugger(); // LINE_A
+  await I.Isolate.spawn(child, null, debugName: 'spawned');
+}
+
+final tests = <IsolateTest>[
+  hasStoppedAtBreakpoint,
+  stoppedAtLine(LINE_A),
+  (VmService service, IsolateRef isolateRef) async {
+    // Filling the pool does not hold up the first spawn, so wait for it.
+    Set<String> pooledIds;
+    while (true) {
+      final vm = await service.getVM();
+      pooledIds = {
+        for (final isolate in vm.isolates!)
+          if (isolate.name == 'pooled-isolate') isolate.id!,
+      };
+      if (pooledIds.length == poolSize) break;
+      await Future.delayed(const Duration(milliseconds: 10));
+    }
+
+    final renamed = Completer<IsolateRef>();
+    late final StreamSubscription sub;
+    sub = service.onIsolateEvent.listen((event) async {
+      if (event.kind == EventKind.kIsolateUpdate &&
+          event.isolate!.name == 'spawned') {
+        await sub.cancel();
+        await service.streamCancel(EventStreams.kIsolate);
+        renamed.complete(event.isolate!);
+      }
+    });
+    await service.streamListen(EventStreams.kIsolate);
+
+    // The spawned isolate is taken from the pool and tooling is told about
+    // its new name.
+    await service.resume(isolateRef.id!);
+    expect(pooledIds, contains((await renamed.future).id));
+  },
+];
+
+void main([args = const <String>[]]) => runIsolateTests(
+      args,
+      tests,
+      'isolate_spawn_pool_test.dart',
+      testeeConcurrent: during,
+      extraArgs: ['--isolate_spawn_pool_size=$poolSize'],
+    );
@@ -0,0 +1,77 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:test/test.dart';
+import 'package:vm_service/src/vm_service.dart';
+
+import '../common/test_helper.dart';
+
+class GCStatistics extends Response {
+  static GCStatistics? parse(Map<String, dynamic>? json) =>
+      json == null ? null : GCStatistics._fromJson(json);
+
+  GCStatistics._fromJson(Map<String, dynamic> json)
+      : pauses = json['pauses'].cast<Map<String, dynamic>>(),
+        concurrentMark = json['concurrentMark'],
+        concurrentSweep = json['concurrentSweep'],
+        promotedBytes = json['promotedBytes'],
+        storeBufferOverflows = json['storeBufferOverflows'],
+        unsweptPages = json['unsweptPages'];
+
+  @override
+  String get type => '_GCStatistics';
+
+  final List<Map<String, dynamic>> pauses;
+  final Map<String, dynamic> concurrentMark;
+  final Map<String, dynamic> concurrentSweep;
+  final int promotedBytes;
+  final int storeBufferOverflows;
+  final int unsweptPages;
+}
+
+extension on VmService {
+  Future<GCStatistics> getGCStatistics(String isolateId) async =>
+      await callMethod('_getGCStatistics', isolateId: isolateId)
+          as GCStatistics;
+}
+
+void expectHistogram(Map<String, dynamic> histogram) {
+  final buckets = histogram['buckets'].cast<int>();
+  expect(buckets, isNotEmpty);
+  expect(buckets.fold<int>(0, (a, b) => a + b), histogram['count']);
+  expect(histogram['maxMicros'], lessThanOrEqualTo(histogram['totalMicros']));
+}
+
+final tests = <IsolateTest>[
+  (VmService service, IsolateRef isolateRef) async {
+    // Setup
+    addTypeFactory('_GCStatistics', GCStatistics.parse);
+  },
+  (VmService service, IsolateRef isolateRef) async {
+    final isolateId = isolateRef.id!;
+    await service.getAllocationProfile(isolateId, gc: true);
+    final result = await service.getGCStatistics(isolateId);
+    expect(result.pauses, isNotEmpty);
+    for (final pauses in result.pauses) {
+      expect(pauses['reason'], isA<String>());
+      expectHistogram(pauses);
+    }
+    final pauseCount = result.pauses.fold<int>(
+      0,
+      (a, pauses) => a + (pauses['count'] as int),
+    );
+    expect(pauseCount, isPositive);
+    expectHistogram(result.concurrentMark);
+    expectHistogram(result.concurrentSweep);
+    expect(result.promotedBytes, greaterThanOrEqualTo(0));
+    expect(result.storeBufferOverflows, greaterThanOrEqualTo(0));
+    expect(result.unsweptPages, greaterThanOrEqualTo(0));
+  },
+];
+
+void main([args = const <String>[]]) => runIsolateTests(
+      args,
+      tests,
+      'get_gc_statistics_rpc_test.dart',
+    );
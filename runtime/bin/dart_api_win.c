@@ -102,6 +102,8 @@ typedef void (*Dart_NotifyDestroyedType)();
 typedef void (*Dart_NotifyLowMemoryType)();
 typedef Dart_PerformanceMode (*Dart_SetPerformanceModeType)(
     Dart_PerformanceMode);
+typedef Dart_Handle (*Dart_SetGCGoalsType)(int64_t, intptr_t);
+typedef void (*Dart_GetGCStatisticsType)(Dart_GCStatistics*);
 typedef void (*Dart_StartProfilingType)();
 typedef void (*Dart_StopProfilingType)();
 typedef void (*Dart_ThreadDisableProfilingType)();
@@ -512,6 +514,8 @@ static Dart_SetHeapSamplingPeriodType Dart_SetHeapSamplingPeriodFn = NULL;
 static Dart_NotifyDestroyedType Dart_NotifyDestroyedFn = NULL;
 static Dart_NotifyLowMemoryType Dart_NotifyLowMemoryFn = NULL;
 static Dart_SetPerformanceModeType Dart_SetPerformanceModeFn = NULL;
+static Dart_SetGCGoalsType Dart_SetGCGoalsFn = NULL;
+static Dart_GetGCStatisticsType Dart_GetGCStatisticsFn = NULL;
 static Dart_StartProfilingType Dart_StartProfilingFn = NULL;
 static Dart_StopProfilingType Dart_StopProfilingFn = NULL;
 static Dart_ThreadDisableProfilingType Dart_ThreadDisableProfilingFn = NULL;
@@ -870,6 +874,10 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved) {
         process, "Dart_NotifyLowMemory");
     Dart_SetPerformanceModeFn = (Dart_SetPerformanceModeType)GetProcAddress(
         process, "Dart_SetPerformanceMode");
+    Dart_SetGCGoalsFn =
+        (Dart_SetGCGoalsType)GetProcAddress(process, "Dart_SetGCGoals");
+    Dart_GetGCStatisticsFn = (Dart_GetGCStatisticsType)GetProcAddress(
+        process, "Dart_GetGCStatistics");
     Dart_StartProfilingFn =
         (Dart_StartProfilingType)GetProcAddress(process, "Dart_StartProfiling");
     Dart_StopProfilingFn =
@@ -1597,6 +1605,15 @@ Dart_PerformanceMode Dart_SetPerformanceMode(Dart_PerformanceMode mode) {
   return Dart_SetPerformanceModeFn(mode);
 }
 
+Dart_Handle Dart_SetGCGoals(int64_t max_pause_micros,
+                            intptr_t max_gc_time_percent) {
+  return Dart_SetGCGoalsFn(max_pause_micros, max_gc_time_percent);
+}
+
+void Dart_GetGCStatistics(Dart_GCStatistics* statistics) {
+  Dart_GetGCStatisticsFn(statistics);
+}
+
 void Dart_StartProfiling() {
   Dart_StartProfilingFn();
 }
@@ -332,6 +332,7 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
   dir_listing->SetArray(response, kArraySize);
   Directory::List(dir_listing);
+  dir_listing->FlushBatch();
   // In case the listing ended before it hit the buffer length, we need to
   // override the array length.
   response->AsApiCObject()->value.as_array.length = dir_listing->index();
@@ -378,6 +379,7 @@ CObject* Directory::RenameRequest(const CObjectArray& request) {
 
 bool AsyncDirectoryListing::AddFileSystemEntityToResponse(Response type,
                                                           const char* arg) {
+  FlushBatch();
   array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(type)));
   if (arg != nullptr) {
     size_t len = strlen(arg);
@@ -394,16 +396,46 @@ bool AsyncDirectoryListing::AddFileSystemEntityToResponse(Response type,
   return index_ < length_;
 }
 
+bool AsyncDirectoryListing::AddFileSystemEntityToBatch(Response type,
+                                                       const char* arg) {
+  const intptr_t len = strlen(arg);
+  const intptr_t required = batch_length_ + kBatchEntryHeaderLength + len;
+  if (required > batch_capacity_) {
+    batch_capacity_ = Utils::Maximum(2 * batch_capacity_, required);
+    batch_ = reinterpret_cast<uint8_t*>(realloc(batch_, batch_capacity_));
+  }
+  uint8_t* entry = batch_ + batch_length_;
+  entry[0] = static_cast<uint8_t>(type);
+  for (intptr_t i = 0; i < 4; i++) {
+    entry[1 + i] = static_cast<uint8_t>(len >> (8 * i));
+  }
+  memmove(entry + kBatchEntryHeaderLength, arg, len);
+  batch_length_ = required;
+  // Leave room in the response for the batch and an error or done entry.
+  return (batch_length_ < kMaxBatchLength) && (index_ + 4 <= length_);
+}
+
+void AsyncDirectoryListing::FlushBatch() {
+  if (batch_length_ == 0) {
+    return;
+  }
+  Dart_CObject* io_buffer = CObject::NewIOBuffer(batch_length_);
+  memmove(io_buffer->value.as_external_typed_data.data, batch_, batch_length_);
+  array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(kListBatch)));
+  array_->SetAt(index_++, new CObjectExternalUint8Array(io_buffer));
+  batch_length_ = 0;
+}
+
 bool AsyncDirectoryListing::HandleDirectory(const char* dir_name) {
-  return AddFileSystemEntityToResponse(kListDirectory, dir_name);
+  return AddFileSystemEntityToBatch(kListDirectory, dir_name);
 }
 
 bool AsyncDirectoryListing::HandleFile(const char* file_name) {
-  return AddFileSystemEntityToResponse(kListFile, file_name);
+  return AddFileSystemEntityToBatch(kListFile, file_name);
 }
 
 bool AsyncDirectoryListing::HandleLink(const char* link_name) {
-  return AddFileSystemEntityToResponse(kListLink, link_name);
+  return AddFileSystemEntityToBatch(kListLink, link_name);
 }
 
 void AsyncDirectoryListing::HandleDone() {
@@ -412,6 +444,7 @@ void AsyncDirectoryListing::HandleDone() {
 
 bool AsyncDirectoryListing::HandleError() {
   CObject* err = CObject::NewOSError();
+  FlushBatch();
   array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(kListError)));
   CObjectArray* response = new CObjectArray(CObject::NewArray(3));
   response->SetAt(0, new CObjectInt32(CObject::NewInt32(kListError)));
@@ -161,7 +161,8 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
     kListDirectory = 1,
     kListLink = 2,
     kListError = 3,
-    kListDone = 4
+    kListDone = 4,
+    kListBatch = 5
   };
 
   AsyncDirectoryListing(Namespace* namespc,
@@ -172,7 +173,10 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
         DirectoryListing(namespc, dir_name, recursive, follow_links),
         array_(nullptr),
         index_(0),
-        length_(0) {}
+        length_(0),
+        batch_(nullptr),
+        batch_length_(0),
+        batch_capacity_(0) {}
 
   virtual bool HandleDirectory(const char* dir_name);
   virtual bool HandleFile(const char* file_name);
@@ -189,12 +193,25 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
 
   intptr_t index() const { return index_; }
 
+  // Adds the entries batched so far to the response array.
+  void FlushBatch();
+
  private:
-  virtual ~AsyncDirectoryListing() {}
+  // Files, directories and links are packed into a single buffer per
+  // response, each as a type byte, a 32-bit little-endian length and the
+  // path, instead of being sent as separate objects.
+  static constexpr intptr_t kMaxBatchLength = 256 * KB;
+  static constexpr intptr_t kBatchEntryHeaderLength = 5;
+
+  virtual ~AsyncDirectoryListing() { free(batch_); }
   bool AddFileSystemEntityToResponse(Response response, const char* arg);
+  bool AddFileSystemEntityToBatch(Response response, const char* arg);
   CObjectArray* array_;
   intptr_t index_;
   intptr_t length_;
+  uint8_t* batch_;
+  intptr_t batch_length_;
+  intptr_t batch_capacity_;
 
   friend class ReferenceCounted<AsyncDirectoryListing>;
   DISALLOW_IMPLICIT_CONSTRUCTORS(AsyncDirectoryListing);
@@ -7,14 +7,15 @@
 
 #include "bin/directory.h"
 
-#include <dirent.h>     // NOLINT
-#include <errno.h>      // NOLINT
-#include <fcntl.h>      // NOLINT
-#include <stdlib.h>     // NOLINT
-#include <string.h>     // NOLINT
-#include <sys/param.h>  // NOLINT
-#include <sys/stat.h>   // NOLINT
-#include <unistd.h>     // NOLINT
+#include <dirent.h>       // NOLINT
+#include <errno.h>        // NOLINT
+#include <fcntl.h>        // NOLINT
+#include <stdlib.h>       // NOLINT
+#include <string.h>       // NOLINT
+#include <sys/param.h>    // NOLINT
+#include <sys/stat.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
 
 #include "bin/crypto.h"
 #include "bin/dartutils.h"
@@ -80,6 +81,36 @@ struct LinkList {
   LinkList* next;
 };
 
+// Directory entries are read with getdents64 directly, into a buffer larger
+// than the one readdir uses, so that large directories are listed with fewer
+// system calls.
+struct DirectoryBuffer {
+  static constexpr intptr_t kSize = 64 * KB;
+
+  DirectoryBuffer() : position(0), length(0) {}
+
+  // Returns the next entry, or nullptr at the end of the directory or on
+  // error, in which case errno is set.
+  dirent64* Next(int fd) {
+    if (position >= length) {
+      const intptr_t result =
+          TEMP_FAILURE_RETRY(syscall(SYS_getdents64, fd, data, kSize));
+      if (result <= 0) {
+        return nullptr;
+      }
+      position = 0;
+      length = result;
+    }
+    dirent64* entry = reinterpret_cast<dirent64*>(data + position);
+    position += entry->d_reclen;
+    return entry;
+  }
+
+  intptr_t position;
+  intptr_t length;
+  alignas(dirent64) uint8_t data[kSize];
+};
+
 ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   if (done_) {
     return kListDone;
@@ -98,13 +129,7 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   }
 
   if (lister_ == 0) {
-    do {
-      lister_ = reinterpret_cast<intptr_t>(fdopendir(fd_));
-    } while ((lister_ == 0) && (errno == EINTR));
-    if (lister_ == 0) {
-      done_ = true;
-      return kListError;
-    }
+    lister_ = reinterpret_cast<intptr_t>(new DirectoryBuffer());
     if (parent_ != nullptr) {
       if (!listing->path_buffer().Add(File::PathSeparator())) {
         return kListError;
@@ -119,7 +144,7 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   // Iterate the directory and post the directories and files to the
   // ports.
   errno = 0;
-  dirent* entry = readdir(reinterpret_cast<DIR*>(lister_));
+  dirent64* entry = reinterpret_cast<DirectoryBuffer*>(lister_)->Next(fd_);
   if (entry != nullptr) {
     if (!listing->path_buffer().Add(entry->d_name)) {
       done_ = true;
@@ -223,9 +248,9 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
 
 DirectoryListingEntry::~DirectoryListingEntry() {
   ResetLink();
-  if (lister_ != 0) {
-    // This also closes fd_.
-    VOID_NO_RETRY_EXPECTED(closedir(reinterpret_cast<DIR*>(lister_)));
+  delete reinterpret_cast<DirectoryBuffer*>(lister_);
+  if (fd_ != -1) {
+    FDUtils::SaveErrorAndClose(fd_);
   }
 }
 
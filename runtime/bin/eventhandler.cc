@@ -15,17 +15,36 @@
 namespace dart {
 namespace bin {
 
-static EventHandler* event_handler = nullptr;
+static EventHandler** event_handlers = nullptr;
+static intptr_t event_handler_count = 0;
 static Monitor* shutdown_monitor = nullptr;
 
+intptr_t EventHandler::thread_count_ = 1;
+
+void EventHandler::set_thread_count(intptr_t count) {
+  ASSERT(event_handlers == nullptr);
+  ASSERT((count >= 1) && (count <= kMaxThreads));
+  thread_count_ = count;
+}
+
 void EventHandler::Start() {
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
 
-  ASSERT(event_handler == nullptr);
+  ASSERT(event_handlers == nullptr);
   shutdown_monitor = new Monitor();
-  event_handler = new EventHandler();
-  event_handler->delegate_.Start(event_handler);
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  event_handler_count = thread_count_;
+#else
+  // The other implementations keep global state in a single handler, e.g. the
+  // completion port on Windows.
+  event_handler_count = 1;
+#endif
+  event_handlers = new EventHandler*[event_handler_count];
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    event_handlers[i] = new EventHandler();
+    event_handlers[i]->delegate_.Start(event_handlers[i]);
+  }
 
   if (!SocketBase::Initialize()) {
     FATAL("Failed to initialize sockets");
@@ -38,22 +57,27 @@ void EventHandler::NotifyShutdownDone() {
 }
 
 void EventHandler::Stop() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return;
   }
 
-  // Wait until it has stopped.
-  {
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    // Wait until it has stopped.
     MonitorLocker ml(shutdown_monitor);
 
     // Signal to event handler that we want it to stop.
-    event_handler->delegate_.Shutdown();
+    event_handlers[i]->delegate_.Shutdown();
     ml.Wait(Monitor::kNoTimeout);
   }
+  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
 
   // Cleanup
-  delete event_handler;
-  event_handler = nullptr;
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    delete event_handlers[i];
+  }
+  delete[] event_handlers;
+  event_handlers = nullptr;
+  event_handler_count = 0;
   delete shutdown_monitor;
   shutdown_monitor = nullptr;
 
@@ -62,14 +86,40 @@ void EventHandler::Stop() {
 }
 
 EventHandlerImplementation* EventHandler::delegate() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return nullptr;
   }
-  return &event_handler->delegate_;
+  return &event_handlers[0]->delegate_;
+}
+
+// Sockets are assigned to event handler threads by file descriptor, so that
+// all messages for a descriptor, including a listening socket shared between
+// isolates, are handled in order by the thread that has it registered. A
+// descriptor number is only reused after the handler owning it closed it.
+// Timers are assigned by port.
+EventHandler* EventHandler::HandlerFor(intptr_t id, Dart_Port port) {
+  if (event_handler_count == 1) {
+    return event_handlers[0];
+  }
+  if (id == kTimerId) {
+    return event_handlers[Utils::WordHash(static_cast<intptr_t>(port)) %
+                          event_handler_count];
+  }
+  // The handler is chosen by the first message, which is sent while the
+  // descriptor is open, and kept: the descriptor may be closed by the time
+  // later messages are sent.
+  Socket* socket = reinterpret_cast<Socket*>(id);
+  intptr_t index = socket->event_handler_index();
+  if (index == -1) {
+    const intptr_t fd = Utils::Maximum<intptr_t>(socket->fd(), 0);
+    index = Utils::WordHash(fd) % event_handler_count;
+    socket->set_event_handler_index(index);
+  }
+  return event_handlers[index];
 }
 
 void EventHandler::SendFromNative(intptr_t id, Dart_Port port, int64_t data) {
-  event_handler->SendData(id, port, data);
+  HandlerFor(id, port)->SendData(id, port, data);
 }
 
 /*
@@ -98,7 +148,7 @@ void FUNCTION_NAME(EventHandler_SendData)(Dart_NativeArguments args) {
     id = reinterpret_cast<intptr_t>(socket);
   }
   int64_t data = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
-  event_handler->SendData(id, dart_port, data);
+  EventHandler::HandlerFor(id, dart_port)->SendData(id, dart_port, data);
 }
 
 void FUNCTION_NAME(EventHandler_TimerMillisecondClock)(
@@ -611,6 +611,8 @@ namespace bin {
 
 class EventHandler {
  public:
+  static constexpr intptr_t kMaxThreads = 64;
+
   EventHandler() {}
   void SendData(intptr_t id, Dart_Port dart_port, int64_t data) {
     delegate_.SendData(id, dart_port, data);
@@ -632,14 +634,26 @@ class EventHandler {
    */
   static void Stop();
 
+  /**
+   * Set the number of event-handler threads. Must be called before Start.
+   * Only the Linux and Android implementations use more than one thread.
+   */
+  static void set_thread_count(intptr_t count);
+
+  // Returns the implementation of the first event-handler thread.
   static EventHandlerImplementation* delegate();
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  // Returns the event handler responsible for the socket or timer [id].
+  static EventHandler* HandlerFor(intptr_t id, Dart_Port port);
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static intptr_t thread_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
@@ -12,6 +12,7 @@
 #include <fcntl.h>        // NOLINT
 #include <pthread.h>      // NOLINT
 #include <stdio.h>        // NOLINT
+#include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/epoll.h>    // NOLINT
 #include <sys/stat.h>     // NOLINT
@@ -20,6 +21,9 @@
 
 #include "bin/dartutils.h"
 #include "bin/fdutils.h"
+#if defined(DART_HOST_OS_LINUX)
+#include "bin/io_uring_linux.h"
+#endif
 #include "bin/lockers.h"
 #include "bin/process.h"
 #include "bin/socket.h"
@@ -70,8 +74,27 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
+#if defined(DART_HAS_IO_URING)
+// io_uring completions that do not belong to a DescriptorInfo. Descriptor
+// polls carry the descriptor's fd + 1 in their upper 32 bits, see NextPollId.
+static constexpr uint64_t kInterruptPollId = 1;
+static constexpr uint64_t kTimerPollId = 2;
+static constexpr uint64_t kPollRemoveId = 3;
+
+static constexpr uint32_t kIOUringEntries = 256;
+
+// The io_uring backend is opt-in while it sees wider use.
+static bool UseIOUring() {
+  const char* value = getenv("DART_EVENTHANDLER_IO_URING");
+  return (value != nullptr) && (strcmp(value, "1") == 0);
+}
+#endif
+
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+    : socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      epoll_fd_(-1),
+      ring_(nullptr),
+      next_poll_generation_(0) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe2(interrupt_fds_, O_CLOEXEC));
   if (result != 0) {
@@ -81,6 +104,23 @@ EventHandlerImplementation::EventHandlerImplementation()
     FATAL("Failed to set pipe fd non blocking\n");
   }
   shutdown_ = false;
+  timer_fd_ = NO_RETRY_EXPECTED(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC));
+  if (timer_fd_ == -1) {
+    FATAL("Failed creating timerfd file descriptor: %i", errno);
+  }
+#if defined(DART_HAS_IO_URING)
+  if (UseIOUring()) {
+    ring_ = IOUring::Create(kIOUringEntries);
+  }
+  if (ring_ != nullptr) {
+    // Like their epoll registrations below, the interrupt fd and the timer_fd_
+    // are polled level-triggered: one-shot polls re-armed after every
+    // completion.
+    ring_->PollAdd(interrupt_fds_[0], EPOLLIN, false, kInterruptPollId);
+    ring_->PollAdd(timer_fd_, EPOLLIN, false, kTimerPollId);
+    return;
+  }
+#endif
   // The initial size passed to epoll_create is ignore on newer (>=
   // 2.6.8) Linux versions
   epoll_fd_ = NO_RETRY_EXPECTED(epoll_create1(O_CLOEXEC));
@@ -96,10 +136,6 @@ EventHandlerImplementation::EventHandlerImplementation()
   if (status == -1) {
     FATAL("Failed adding interrupt fd to epoll instance");
   }
-  timer_fd_ = NO_RETRY_EXPECTED(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC));
-  if (timer_fd_ == -1) {
-    FATAL("Failed creating timerfd file descriptor: %i", errno);
-  }
   // Register the timer_fd_ with the epoll instance.
   event.events = EPOLLIN;
   event.data.fd = timer_fd_;
@@ -119,7 +155,12 @@ static void DeleteDescriptorInfo(void* info) {
 
 EventHandlerImplementation::~EventHandlerImplementation() {
   socket_map_.Clear(DeleteDescriptorInfo);
-  close(epoll_fd_);
+#if defined(DART_HAS_IO_URING)
+  delete ring_;
+#endif
+  if (epoll_fd_ != -1) {
+    close(epoll_fd_);
+  }
   close(timer_fd_);
   close(interrupt_fds_[0]);
   close(interrupt_fds_[1]);
@@ -127,6 +168,10 @@ EventHandlerImplementation::~EventHandlerImplementation() {
 
 void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
                                                      DescriptorInfo* di) {
+  if (ring_ != nullptr) {
+    UpdatePoll(di);
+    return;
+  }
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
@@ -226,6 +271,13 @@ void EventHandlerImplementation::HandleInterruptFd() {
         }
         intptr_t new_mask = di->Mask();
         UpdateEpollInstance(old_mask, di);
+#if defined(DART_HAS_IO_URING)
+        if (ring_ != nullptr) {
+          // Cancel the poll before the descriptor can be closed and its
+          // number reused.
+          ring_->Submit();
+        }
+#endif
 
         intptr_t fd = di->fd();
         ASSERT(fd == socket->fd());
@@ -340,6 +392,21 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
   return event_mask;
 }
 
+void EventHandlerImplementation::HandleDescriptorEvents(DescriptorInfo* di,
+                                                        intptr_t events) {
+  const intptr_t old_mask = di->Mask();
+  const intptr_t event_mask = GetPollEvents(events, di);
+  if ((event_mask & (1 << kErrorEvent)) != 0) {
+    di->NotifyAllDartPorts(event_mask);
+    UpdateEpollInstance(old_mask, di);
+  } else if (event_mask != 0) {
+    Dart_Port port = di->NextNotifyDartPort(event_mask);
+    ASSERT(port != 0);
+    UpdateEpollInstance(old_mask, di);
+    DartUtils::PostInt32(port, event_mask);
+  }
+}
+
 void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
                                               int size) {
   bool interrupt_seen = false;
@@ -358,17 +425,7 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
     } else {
       DescriptorInfo* di =
           reinterpret_cast<DescriptorInfo*>(events[i].data.ptr);
-      const intptr_t old_mask = di->Mask();
-      const intptr_t event_mask = GetPollEvents(events[i].events, di);
-      if ((event_mask & (1 << kErrorEvent)) != 0) {
-        di->NotifyAllDartPorts(event_mask);
-        UpdateEpollInstance(old_mask, di);
-      } else if (event_mask != 0) {
-        Dart_Port port = di->NextNotifyDartPort(event_mask);
-        ASSERT(port != 0);
-        UpdateEpollInstance(old_mask, di);
-        DartUtils::PostInt32(port, event_mask);
-      }
+      HandleDescriptorEvents(di, events[i].events);
     }
   }
   if (interrupt_seen) {
@@ -386,6 +443,10 @@ void EventHandlerImplementation::Poll(uword args) {
   EventHandlerImplementation* handler_impl = &handler->delegate_;
   ASSERT(handler_impl != nullptr);
 
+  if (handler_impl->ring_ != nullptr) {
+    // Returns on shutdown.
+    handler_impl->PollIOUring();
+  }
   while (!handler_impl->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
         epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
@@ -398,10 +459,130 @@ void EventHandlerImplementation::Poll(uword args) {
       handler_impl->HandleEvents(events, result);
     }
   }
-  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+  // Sockets may still be referenced by the other event-handler threads, so
+  // their count is checked once all have stopped.
   handler->NotifyShutdownDone();
 }
 
+// With io_uring every descriptor with a non-zero mask has a poll armed:
+// multishot, and thus edge-triggered like the epoll registration, for
+// connected sockets and pipes, and one-shot for listening sockets, which are
+// re-armed after every completion to keep them level-triggered. Polls are
+// only queued here; they reach the kernel with the io_uring_enter call that
+// waits for the next completions, so a batch of events and the
+// re-registrations they cause costs a single system call.
+void EventHandlerImplementation::UpdatePoll(DescriptorInfo* di) {
+#if defined(DART_HAS_IO_URING)
+  ASSERT(ring_ != nullptr);
+  const uint32_t events =
+      (di->Mask() != 0) ? (EPOLLRDHUP | di->GetPollEvents()) : 0;
+  if (di->poll_id() != 0) {
+    if (di->poll_events() == events) {
+      return;
+    }
+    ring_->PollRemove(di->poll_id(), kPollRemoveId);
+    di->set_poll(0, 0);
+  }
+  if (events != 0) {
+    const uint64_t id = NextPollId(di->fd());
+    ring_->PollAdd(di->fd(), events, !di->IsListeningSocket(), id);
+    di->set_poll(id, events);
+  }
+#else
+  UNREACHABLE();
+#endif
+}
+
+// Completions of cancelled polls, and of polls for descriptors that have
+// since been closed, may still be in flight. Every armed poll therefore gets
+// a fresh id, and completions whose id does not match the one recorded in
+// the descriptor are dropped.
+uint64_t EventHandlerImplementation::NextPollId(intptr_t fd) {
+  next_poll_generation_++;
+  if (next_poll_generation_ == 0) {
+    next_poll_generation_++;
+  }
+  return (static_cast<uint64_t>(fd + 1) << 32) | next_poll_generation_;
+}
+
+void EventHandlerImplementation::HandleCompletion(uint64_t user_data,
+                                                  int32_t result,
+                                                  uint32_t flags,
+                                                  bool* interrupt_seen) {
+#if defined(DART_HAS_IO_URING)
+  if (user_data == kInterruptPollId) {
+    *interrupt_seen = true;
+    ring_->PollAdd(interrupt_fds_[0], EPOLLIN, false, kInterruptPollId);
+  } else if (user_data == kTimerPollId) {
+    if (result > 0) {
+      int64_t val;
+      VOID_TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+          read(timer_fd_, &val, sizeof(val)));
+      if (timeout_queue_.HasTimeout()) {
+        DartUtils::PostNull(timeout_queue_.CurrentPort());
+        timeout_queue_.RemoveCurrent();
+      }
+      UpdateTimerFd();
+    }
+    ring_->PollAdd(timer_fd_, EPOLLIN, false, kTimerPollId);
+  } else if (user_data != kPollRemoveId) {
+    const intptr_t fd = static_cast<intptr_t>(user_data >> 32) - 1;
+    SimpleHashMap::Entry* entry = socket_map_.Lookup(
+        GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), false);
+    if (entry == nullptr) {
+      return;
+    }
+    DescriptorInfo* di = reinterpret_cast<DescriptorInfo*>(entry->value);
+    if (di->poll_id() != user_data) {
+      return;
+    }
+    if ((flags & IORING_CQE_F_MORE) == 0) {
+      di->set_poll(0, 0);
+    }
+    if ((result == -ECANCELED) || (result == -ENOMEM)) {
+      // The kernel ended a multishot poll on its own, e.g. because the
+      // completion queue overflowed. The descriptor is fine, so arm a new
+      // poll, which completes at once if it is already ready.
+      UpdatePoll(di);
+      return;
+    }
+    if (result < 0) {
+      // The poll was refused, e.g. because the descriptor was closed behind
+      // our back. As with a failed epoll registration, report the
+      // descriptor as closed and only retry once its mask changes.
+      di->NotifyAllDartPorts(1 << kCloseEvent);
+      return;
+    }
+    HandleDescriptorEvents(di, result);
+    // Re-arm polls the kernel has finished with.
+    UpdatePoll(di);
+  }
+#else
+  UNREACHABLE();
+#endif
+}
+
+void EventHandlerImplementation::PollIOUring() {
+#if defined(DART_HAS_IO_URING)
+  while (!shutdown_) {
+    // Interrupted waits are retried after reaping whatever completed.
+    ring_->SubmitAndWait();
+    bool interrupt_seen = false;
+    ring_->ForEachCompletion(
+        [&](uint64_t user_data, int32_t result, uint32_t flags) {
+          HandleCompletion(user_data, result, flags, &interrupt_seen);
+        });
+    if (interrupt_seen) {
+      // Handle after socket events, so we avoid closing a socket before we
+      // handle the current events.
+      HandleInterruptFd();
+    }
+  }
+#else
+  UNREACHABLE();
+#endif
+}
+
 void EventHandlerImplementation::Start(EventHandler* handler) {
   Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
                 reinterpret_cast<uword>(handler));
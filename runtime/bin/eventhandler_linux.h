@@ -20,6 +20,8 @@
 namespace dart {
 namespace bin {
 
+class IOUring;
+
 class DescriptorInfo : public DescriptorInfoBase {
  public:
   explicit DescriptorInfo(intptr_t fd) : DescriptorInfoBase(fd) {}
@@ -33,7 +35,19 @@ class DescriptorInfo : public DescriptorInfoBase {
     fd_ = -1;
   }
 
+  // The io_uring poll currently armed for this descriptor, or 0, and the
+  // events it waits for. Only used when the event handler runs on io_uring.
+  uint64_t poll_id() const { return poll_id_; }
+  uint32_t poll_events() const { return poll_events_; }
+  void set_poll(uint64_t id, uint32_t events) {
+    poll_id_ = id;
+    poll_events_ = events;
+  }
+
  private:
+  uint64_t poll_id_ = 0;
+  uint32_t poll_events_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfo);
 };
 
@@ -73,7 +87,18 @@ class EventHandlerImplementation {
 
  private:
   void HandleEvents(struct epoll_event* events, int size);
+  void HandleDescriptorEvents(DescriptorInfo* di, intptr_t events);
   static void Poll(uword args);
+
+  // The io_uring backend, see io_uring_linux.h.
+  void PollIOUring();
+  void HandleCompletion(uint64_t user_data,
+                        int32_t result,
+                        uint32_t flags,
+                        bool* interrupt_seen);
+  void UpdatePoll(DescriptorInfo* di);
+  uint64_t NextPollId(intptr_t fd);
+
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
   void UpdateTimerFd();
@@ -88,6 +113,9 @@ class EventHandlerImplementation {
   int interrupt_fds_[2];
   int epoll_fd_;
   int timer_fd_;
+  // Non-null if readiness is polled through io_uring instead of epoll.
+  IOUring* ring_;
+  uint32_t next_poll_generation_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
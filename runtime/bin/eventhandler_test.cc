@@ -6,6 +6,14 @@
 #include "platform/assert.h"
 #include "vm/unit_test.h"
 
+#if defined(DART_HOST_OS_LINUX)
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "bin/io_uring_linux.h"
+#endif
+
 namespace dart {
 namespace bin {
 
@@ -79,5 +87,59 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
   list.Remove(4242);
 }
 
+#if defined(DART_HAS_IO_URING)
+VM_UNIT_TEST_CASE(IOUringMultishotPoll) {
+  IOUring* ring = IOUring::Create(8);
+  if (ring == nullptr) {
+    // io_uring is unavailable or disabled on this machine.
+    return;
+  }
+  int fds[2];
+  EXPECT_EQ(0, pipe(fds));
+  const uint64_t kPollId = 42;
+  const uint64_t kRemoveId = 43;
+  ring->PollAdd(fds[0], EPOLLIN, true, kPollId);
+
+  // A multishot poll stays armed and completes on every write.
+  for (intptr_t i = 0; i < 3; i++) {
+    EXPECT_EQ(1, write(fds[1], "x", 1));
+    EXPECT(ring->SubmitAndWait());
+    intptr_t completions = 0;
+    ring->ForEachCompletion(
+        [&](uint64_t user_data, int32_t result, uint32_t flags) {
+          EXPECT_EQ(kPollId, user_data);
+          EXPECT((result & EPOLLIN) != 0);
+          EXPECT((flags & IORING_CQE_F_MORE) != 0);
+          completions++;
+        });
+    EXPECT_EQ(1, completions);
+  }
+
+  // Removing the poll completes both the removal and the poll itself.
+  ring->PollRemove(kPollId, kRemoveId);
+  bool removed = false;
+  bool cancelled = false;
+  while (!removed || !cancelled) {
+    EXPECT(ring->SubmitAndWait());
+    ring->ForEachCompletion(
+        [&](uint64_t user_data, int32_t result, uint32_t flags) {
+          if (user_data == kRemoveId) {
+            EXPECT_EQ(0, result);
+            removed = true;
+          } else {
+            EXPECT_EQ(kPollId, user_data);
+            EXPECT_EQ(-ECANCELED, result);
+            EXPECT((flags & IORING_CQE_F_MORE) == 0);
+            cancelled = true;
+          }
+        });
+  }
+
+  delete ring;
+  close(fds[0]);
+  close(fds[1]);
+}
+#endif  // defined(DART_HAS_IO_URING)
+
 }  // namespace bin
 }  // namespace dart
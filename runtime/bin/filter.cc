@@ -6,6 +6,9 @@
 
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
+#include "bin/lockers.h"
+#include "bin/platform.h"
+#include "bin/reference_counting.h"
 
 #include "include/dart_api.h"
 
@@ -122,6 +125,8 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
   int64_t strategy = DartUtils::GetNativeIntegerArgument(args, 5);
   Dart_Handle dict_obj = Dart_GetNativeArgument(args, 6);
   bool raw = DartUtils::GetNativeBooleanArgument(args, 7);
+  int64_t threads = DartUtils::GetNativeIntegerArgument(args, 8);
+  Dart_Handle compress_port_obj = Dart_GetNativeArgument(args, 9);
 
   Dart_Handle err;
   uint8_t* dictionary = nullptr;
@@ -140,10 +145,31 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
     }
   }
 
-  ZLibDeflateFilter* filter = new ZLibDeflateFilter(
-      gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
-      static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
-      dictionary, dictionary_length, raw);
+  Filter* filter;
+  intptr_t filter_size;
+  // The dictionary is only used by zlib streams, which then have to be
+  // compressed as a whole.
+  if ((threads > 1) && ((dictionary == nullptr) || gzip || raw)) {
+    delete[] dictionary;
+    dictionary = nullptr;
+    dictionary_length = 0;
+    Dart_Port compress_port = ILLEGAL_PORT;
+    err = Dart_SendPortGetId(compress_port_obj, &compress_port);
+    if (Dart_IsError(err)) {
+      Dart_PropagateError(err);
+    }
+    filter = new ParallelZLibDeflateFilter(
+        gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
+        static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy), raw,
+        static_cast<intptr_t>(threads), compress_port);
+    filter_size = sizeof(ParallelZLibDeflateFilter);
+  } else {
+    filter = new ZLibDeflateFilter(
+        gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
+        static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
+        dictionary, dictionary_length, raw);
+    filter_size = sizeof(ZLibDeflateFilter) + dictionary_length;
+  }
   if (filter == nullptr) {
     delete[] dictionary;
     Dart_PropagateError(
@@ -154,14 +180,22 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
     Dart_ThrowException(
         DartUtils::NewInternalError("Failed to create ZLibDeflateFilter"));
   }
-  Dart_Handle result = Filter::SetFilterAndCreateFinalizer(
-      filter_obj, filter, sizeof(*filter) + dictionary_length);
+  Dart_Handle result =
+      Filter::SetFilterAndCreateFinalizer(filter_obj, filter, filter_size);
   if (Dart_IsError(result)) {
     delete filter;
     Dart_PropagateError(result);
   }
 }
 
+void FUNCTION_NAME(Filter_NewCompressPort)(Dart_NativeArguments args) {
+  Dart_Port compress_port = ParallelZLibDeflateFilter::NewCompressPort();
+  if (compress_port == ILLEGAL_PORT) {
+    Dart_PropagateError(DartUtils::NewError("Unable to create native port"));
+  }
+  Dart_SetReturnValue(args, Dart_NewSendPort(compress_port));
+}
+
 void FUNCTION_NAME(Filter_Process)(Dart_NativeArguments args) {
   Dart_Handle filter_obj = Dart_GetNativeArgument(args, 0);
   Dart_Handle data_obj = Dart_GetNativeArgument(args, 1);
@@ -363,6 +397,430 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
   return error ? -1 : 0;
 }
 
+// Blocks are shared by the filter and the message posted for them, so that a
+// filter can be finalized while its blocks are still being compressed. The
+// filter claims blocks that no worker has started on before dropping them.
+class ParallelZLibDeflateFilter::Block
+    : public ReferenceCounted<ParallelZLibDeflateFilter::Block> {
+ public:
+  Block(bool gzip,
+        bool raw,
+        int32_t level,
+        int32_t window_bits,
+        int32_t mem_level,
+        int32_t strategy)
+      : gzip(gzip),
+        raw(raw),
+        level(level),
+        window_bits(window_bits),
+        mem_level(mem_level),
+        strategy(strategy),
+        next(nullptr),
+        input(new uint8_t[kMaxWindowSize + kBlockSize]),
+        window_length(0),
+        input_length(0),
+        last(false),
+        output(nullptr),
+        output_length(0),
+        output_position(0),
+        check(0),
+        started(false),
+        done(false),
+        error(false) {}
+
+  // Compresses the block unless it has already been claimed by another
+  // thread. Returns whether it was compressed by this call.
+  bool Compress();
+
+  // Prevents the block from being compressed, unless that has started.
+  void Abandon() {
+    MonitorLocker ml(&monitor);
+    started = true;
+  }
+
+  bool IsStarted() {
+    MonitorLocker ml(&monitor);
+    return started;
+  }
+
+  bool IsDone() {
+    MonitorLocker ml(&monitor);
+    return done;
+  }
+
+  void WaitUntilDone() {
+    MonitorLocker ml(&monitor);
+    while (!done) {
+      ml.Wait();
+    }
+  }
+
+  const bool gzip;
+  const bool raw;
+  const int32_t level;
+  const int32_t window_bits;
+  const int32_t mem_level;
+  const int32_t strategy;
+
+  Block* next;
+
+  // The window preceding the block, followed by the block's own input.
+  uint8_t* const input;
+  intptr_t window_length;
+  intptr_t input_length;
+  bool last;
+
+  // Written by the compressing thread before done is set.
+  uint8_t* output;
+  intptr_t output_length;
+  intptr_t output_position;
+  uint32_t check;
+
+ private:
+  ~Block() {
+    delete[] input;
+    free(output);
+  }
+
+  Monitor monitor;
+  bool started;
+  bool done;
+  bool error;
+
+  friend class ParallelZLibDeflateFilter;
+  friend class ReferenceCounted<Block>;
+  DISALLOW_COPY_AND_ASSIGN(Block);
+};
+
+bool ParallelZLibDeflateFilter::Block::Compress() {
+  {
+    MonitorLocker ml(&monitor);
+    if (started) {
+      return false;
+    }
+    started = true;
+  }
+
+  uint8_t* data = input + window_length;
+  uInt data_length = static_cast<uInt>(input_length);
+  uint32_t data_check = 0;
+  if (raw) {
+    // Raw streams have no check value, even when gzip is also requested.
+  } else if (gzip) {
+    data_check = crc32(crc32(0, Z_NULL, 0), data, data_length);
+  } else {
+    data_check = adler32(adler32(0, Z_NULL, 0), data, data_length);
+  }
+
+  // Each block is a raw deflate stream. All but the last end on a byte
+  // boundary after a sync flush so that they can be concatenated.
+  int bits = (window_bits == 8) ? 9 : window_bits;
+  z_stream stream;
+  stream.next_in = Z_NULL;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  uint8_t* data_output = nullptr;
+  intptr_t data_output_length = 0;
+  bool data_error = deflateInit2(&stream, level, Z_DEFLATED, -bits, mem_level,
+                                 strategy) != Z_OK;
+  if (!data_error) {
+    if (window_length > 0) {
+      data_error =
+          deflateSetDictionary(&stream, input, window_length) != Z_OK;
+    }
+    // Leave room for the empty stored block written by the sync flush.
+    intptr_t capacity = deflateBound(&stream, data_length) + 16;
+    data_output = reinterpret_cast<uint8_t*>(malloc(capacity));
+    stream.next_in = data;
+    stream.avail_in = data_length;
+    stream.next_out = data_output;
+    stream.avail_out = capacity;
+    while (!data_error) {
+      int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+      if ((result != Z_OK) && (result != Z_STREAM_END) &&
+          (result != Z_BUF_ERROR)) {
+        data_error = true;
+      } else if (last ? (result == Z_STREAM_END) : (stream.avail_out != 0)) {
+        break;
+      } else if (stream.avail_out != 0) {
+        data_error = true;
+      } else {
+        intptr_t used = capacity;
+        capacity *= 2;
+        data_output =
+            reinterpret_cast<uint8_t*>(realloc(data_output, capacity));
+        stream.next_out = data_output + used;
+        stream.avail_out = capacity - used;
+      }
+    }
+    data_output_length = capacity - stream.avail_out;
+    deflateEnd(&stream);
+  }
+
+  MonitorLocker ml(&monitor);
+  output = data_output;
+  output_length = data_output_length;
+  check = data_check;
+  error = data_error;
+  done = true;
+  ml.NotifyAll();
+  return true;
+}
+
+Dart_Port ParallelZLibDeflateFilter::NewCompressPort() {
+  return Dart_NewConcurrentNativePort("dart:io ZLibDeflate", CompressBlock,
+                                      Platform::NumberOfProcessors());
+}
+
+bool ParallelZLibDeflateFilter::PostBlock(Block* block) {
+  block->Retain();
+  if (!Dart_PostInteger(compress_port_, reinterpret_cast<intptr_t>(block))) {
+    block->Release();
+    return false;
+  }
+  return true;
+}
+
+void ParallelZLibDeflateFilter::CompressBlock(Dart_Port dest_port_id,
+                                              Dart_CObject* message) {
+  ASSERT((message->type == Dart_CObject_kInt32) ||
+         (message->type == Dart_CObject_kInt64));
+  intptr_t address = (message->type == Dart_CObject_kInt32)
+                         ? message->value.as_int32
+                         : message->value.as_int64;
+  Block* block = reinterpret_cast<Block*>(address);
+  block->Compress();
+  block->Release();
+}
+
+ParallelZLibDeflateFilter::~ParallelZLibDeflateFilter() {
+  delete[] current_buffer_;
+  // Blocks still being compressed are released by their workers.
+  while (first_pending_ != nullptr) {
+    Block* block = first_pending_;
+    first_pending_ = block->next;
+    block->Abandon();
+    block->Release();
+  }
+  if (block_ != nullptr) {
+    block_->Release();
+  }
+}
+
+bool ParallelZLibDeflateFilter::Init() {
+  // As in ZLibDeflateFilter::Init, a raw stream has no header or trailer even
+  // if gzip is also requested.
+  if (!raw_) {
+    // Let zlib write the header of an empty stream, so that it is the one
+    // ZLibDeflateFilter writes, operating system code included.
+    int window_bits = (window_bits_ == 8) ? 9 : window_bits_;
+    if (gzip_) {
+      window_bits += kZLibFlagUseGZipHeader;
+    }
+    z_stream stream;
+    stream.next_in = Z_NULL;
+    stream.avail_in = 0;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    if (deflateInit2(&stream, level_, Z_DEFLATED, window_bits, mem_level_,
+                     strategy_) != Z_OK) {
+      return false;
+    }
+    uint8_t empty_stream[64];
+    stream.next_out = empty_stream;
+    stream.avail_out = sizeof(empty_stream);
+    int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+      return false;
+    }
+    // The zlib header is 2 bytes, the gzip header without optional fields
+    // 10 bytes.
+    extra_end_ = gzip_ ? 10 : 2;
+    memmove(extra_, empty_stream, extra_end_);
+    check_ = gzip_ ? crc32(0, Z_NULL, 0) : adler32(0, Z_NULL, 0);
+  }
+  block_ = NewBlock(nullptr);
+  set_initialized(true);
+  return true;
+}
+
+bool ParallelZLibDeflateFilter::Process(uint8_t* data, intptr_t length) {
+  if ((current_buffer_ != nullptr) || finished_) {
+    return false;
+  }
+  current_buffer_ = data;
+  current_length_ = length;
+  current_position_ = 0;
+  return true;
+}
+
+// The calling thread does not wait for workers while it has work of its own:
+// it compresses the blocks that do not fit in the pool and those no worker
+// has started on. Only flushing and ending the stream wait, for the blocks
+// that are being compressed on other threads.
+intptr_t ParallelZLibDeflateFilter::Processed(uint8_t* buffer,
+                                              intptr_t length,
+                                              bool flush,
+                                              bool end) {
+  intptr_t processed = 0;
+  while (true) {
+    intptr_t copied = CopyOutput(buffer + processed, length - processed);
+    if (copied < 0) {
+      return -1;
+    }
+    processed += copied;
+    if (processed == length) {
+      break;
+    }
+    bool consumed = current_position_ == current_length_;
+    if (!consumed) {
+      intptr_t count = Utils::Minimum(current_length_ - current_position_,
+                                      kBlockSize - block_->input_length);
+      memmove(block_->input + block_->window_length + block_->input_length,
+              current_buffer_ + current_position_, count);
+      block_->input_length += count;
+      current_position_ += count;
+      if (block_->input_length == kBlockSize) {
+        SubmitBlock(false);
+      }
+      continue;
+    }
+    if (!finished_ && (end || (flush && (block_->input_length > 0)))) {
+      SubmitBlock(end);
+      continue;
+    }
+    if ((first_pending_ != nullptr) && (flush || end)) {
+      if (!CompressUnstarted()) {
+        first_pending_->WaitUntilDone();
+      }
+      continue;
+    }
+    break;
+  }
+  if (processed == 0) {
+    delete[] current_buffer_;
+    current_buffer_ = nullptr;
+    current_length_ = 0;
+    current_position_ = 0;
+  }
+  return processed;
+}
+
+ParallelZLibDeflateFilter::Block* ParallelZLibDeflateFilter::NewBlock(
+    Block* previous) {
+  Block* block =
+      new Block(gzip_, raw_, level_, window_bits_, mem_level_, strategy_);
+  if (previous != nullptr) {
+    // Prime the block with the data preceding it, so that matches may refer
+    // back across the block boundary.
+    int window_bits = (window_bits_ == 8) ? 9 : window_bits_;
+    intptr_t available = previous->window_length + previous->input_length;
+    block->window_length =
+        Utils::Minimum(available, static_cast<intptr_t>(1) << window_bits);
+    memmove(block->input,
+            previous->input + available - block->window_length,
+            block->window_length);
+  }
+  return block;
+}
+
+void ParallelZLibDeflateFilter::SubmitBlock(bool last) {
+  Block* block = block_;
+  block->last = last;
+  block_ = last ? nullptr : NewBlock(block);
+  finished_ = last;
+  if (last_pending_ == nullptr) {
+    first_pending_ = block;
+  } else {
+    last_pending_->next = block;
+  }
+  last_pending_ = block;
+  pending_blocks_++;
+  if ((pending_blocks_ > max_pending_blocks_) || !PostBlock(block)) {
+    block->Compress();
+  }
+}
+
+bool ParallelZLibDeflateFilter::CompressUnstarted() {
+  for (Block* block = first_pending_; block != nullptr; block = block->next) {
+    if (!block->IsStarted() && block->Compress()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+intptr_t ParallelZLibDeflateFilter::CopyOutput(uint8_t* buffer,
+                                               intptr_t length) {
+  intptr_t copied = 0;
+  while (copied < length) {
+    if (extra_start_ < extra_end_) {
+      intptr_t count =
+          Utils::Minimum(extra_end_ - extra_start_, length - copied);
+      memmove(buffer + copied, extra_ + extra_start_, count);
+      extra_start_ += count;
+      copied += count;
+      continue;
+    }
+    Block* block = first_pending_;
+    if ((block == nullptr) || !block->IsDone()) {
+      break;
+    }
+    if (block->error) {
+      return -1;
+    }
+    intptr_t count = Utils::Minimum(
+        block->output_length - block->output_position, length - copied);
+    memmove(buffer + copied, block->output + block->output_position, count);
+    block->output_position += count;
+    copied += count;
+    if (block->output_position == block->output_length) {
+      if (raw_) {
+        // Raw streams have no check value.
+      } else if (gzip_) {
+        check_ = crc32_combine(check_, block->check, block->input_length);
+      } else {
+        check_ = adler32_combine(check_, block->check, block->input_length);
+      }
+      total_length_ += block->input_length;
+      first_pending_ = block->next;
+      if (first_pending_ == nullptr) {
+        last_pending_ = nullptr;
+      }
+      pending_blocks_--;
+      if (block->last) {
+        WriteTrailer();
+      }
+      block->Release();
+    }
+  }
+  return copied;
+}
+
+void ParallelZLibDeflateFilter::WriteTrailer() {
+  extra_start_ = 0;
+  extra_end_ = 0;
+  if (raw_) {
+    // Raw streams have no trailer.
+  } else if (gzip_) {
+    // CRC-32 and input size modulo 2^32, least significant byte first.
+    for (intptr_t i = 0; i < 4; i++) {
+      extra_[extra_end_++] = static_cast<uint8_t>(check_ >> (8 * i));
+    }
+    for (intptr_t i = 0; i < 4; i++) {
+      extra_[extra_end_++] = static_cast<uint8_t>(total_length_ >> (8 * i));
+    }
+  } else {
+    // Adler-32, most significant byte first.
+    for (intptr_t i = 3; i >= 0; i--) {
+      extra_[extra_end_++] = static_cast<uint8_t>(check_ >> (8 * i));
+    }
+  }
+}
+
 ZLibInflateFilter::~ZLibInflateFilter() {
   delete[] dictionary_;
   delete[] current_buffer_;
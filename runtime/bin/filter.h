@@ -6,8 +6,11 @@
 #define RUNTIME_BIN_FILTER_H_
 
 #include "bin/builtin.h"
+#include "bin/thread.h"
 #include "bin/utils.h"
 
+#include "include/dart_native_api.h"
+
 #include "zlib/zlib.h"
 
 namespace dart {
@@ -95,6 +98,104 @@ class ZLibDeflateFilter : public Filter {
   DISALLOW_COPY_AND_ASSIGN(ZLibDeflateFilter);
 };
 
+// Compresses independent blocks of the input concurrently, in the style of
+// pigz. Each block is a raw deflate stream primed with the window preceding
+// it and ended with a sync flush, so the compressed blocks can simply be
+// concatenated. The zlib or gzip header and trailer are added around them.
+class ParallelZLibDeflateFilter : public Filter {
+ public:
+  ParallelZLibDeflateFilter(bool gzip,
+                            int32_t level,
+                            int32_t window_bits,
+                            int32_t mem_level,
+                            int32_t strategy,
+                            bool raw,
+                            intptr_t threads,
+                            Dart_Port compress_port)
+      : gzip_(gzip),
+        level_(level),
+        window_bits_(window_bits),
+        mem_level_(mem_level),
+        strategy_(strategy),
+        raw_(raw),
+        max_pending_blocks_(threads),
+        compress_port_(compress_port),
+        current_buffer_(nullptr),
+        current_length_(0),
+        current_position_(0),
+        block_(nullptr),
+        first_pending_(nullptr),
+        last_pending_(nullptr),
+        pending_blocks_(0),
+        finished_(false),
+        check_(0),
+        total_length_(0),
+        extra_start_(0),
+        extra_end_(0) {}
+  virtual ~ParallelZLibDeflateFilter();
+
+  // Creates the port whose messages compress blocks on a pool of its own.
+  // Each isolate creates one, on first use, and keeps it open for its life
+  // like the IOService port.
+  static Dart_Port NewCompressPort();
+
+  virtual bool Init();
+  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual intptr_t Processed(uint8_t* buffer,
+                             intptr_t length,
+                             bool finish,
+                             bool end);
+
+ private:
+  class Block;
+
+  static constexpr intptr_t kBlockSize = 128 * KB;
+  static constexpr intptr_t kMaxWindowSize = 32 * KB;
+  // The largest of the zlib and gzip headers and trailers.
+  static constexpr intptr_t kMaxExtraSize = 10;
+
+  static void CompressBlock(Dart_Port dest_port_id, Dart_CObject* message);
+
+  bool PostBlock(Block* block);
+  Block* NewBlock(Block* previous);
+  void SubmitBlock(bool last);
+  bool CompressUnstarted();
+  intptr_t CopyOutput(uint8_t* buffer, intptr_t length);
+  void WriteTrailer();
+
+  const bool gzip_;
+  const int32_t level_;
+  const int32_t window_bits_;
+  const int32_t mem_level_;
+  const int32_t strategy_;
+  const bool raw_;
+  const intptr_t max_pending_blocks_;
+  const Dart_Port compress_port_;
+
+  uint8_t* current_buffer_;
+  intptr_t current_length_;
+  intptr_t current_position_;
+
+  // The block being filled with input.
+  Block* block_;
+  // Submitted blocks whose output has not been consumed yet, in stream order.
+  Block* first_pending_;
+  Block* last_pending_;
+  intptr_t pending_blocks_;
+  bool finished_;
+
+  // Running check value of all consumed blocks and the length of their input.
+  uint32_t check_;
+  int64_t total_length_;
+
+  // Header or trailer bytes waiting to be copied out.
+  uint8_t extra_[kMaxExtraSize];
+  intptr_t extra_start_;
+  intptr_t extra_end_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelZLibDeflateFilter);
+};
+
 class ZLibInflateFilter : public Filter {
  public:
   ZLibInflateFilter(bool gzip,
@@ -78,8 +78,9 @@ namespace bin {
   V(FileSystemWatcher_ReadEvents, 2)                                           \
   V(FileSystemWatcher_UnwatchPath, 2)                                          \
   V(FileSystemWatcher_WatchPath, 5)                                            \
-  V(Filter_CreateZLibDeflate, 8)                                               \
+  V(Filter_CreateZLibDeflate, 10)                                              \
   V(Filter_CreateZLibInflate, 5)                                               \
+  V(Filter_NewCompressPort, 0)                                                 \
   V(Filter_Process, 4)                                                         \
   V(Filter_Processed, 3)                                                       \
   V(ResourceHandleImpl_toFile, 1)                                              \
@@ -164,14 +165,17 @@ namespace bin {
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
   V(Socket_Read, 2)                                                            \
-  V(Socket_RecvFrom, 1)                                                        \
+  V(Socket_ReadInto, 4)                                                        \
+  V(Socket_RecvFrom, 3)                                                        \
   V(Socket_ReceiveMessage, 2)                                                  \
+  V(Socket_SendFile, 4)                                                        \
   V(Socket_SendMessage, 5)                                                     \
   V(Socket_SendTo, 6)                                                          \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteVector, 2)                                                     \
   V(Socket_HasPendingWrite, 1)                                                 \
   V(SocketControlMessage_fromHandles, 2)                                       \
   V(SocketControlMessageImpl_extractHandles, 1)                                \
@@ -0,0 +1,172 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(DART_HOST_OS_LINUX)
+
+#include "bin/io_uring_linux.h"
+
+#if defined(DART_HAS_IO_URING)
+
+#include <errno.h>        // NOLINT
+#include <string.h>       // NOLINT
+#include <sys/mman.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
+
+#include "platform/assert.h"
+#include "platform/signal_blocker.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+// Multishot poll was added in Linux 5.13, which has no feature bit of its own.
+// IORING_FEAT_RSRC_TAGS was introduced by the same release.
+static constexpr uint32_t kRequiredFeatures =
+    IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_RSRC_TAGS;
+
+IOUring* IOUring::Create(uint32_t entries) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+#if defined(IORING_SETUP_CLAMP)
+  params.flags = IORING_SETUP_CLAMP;
+#endif
+  const int ring_fd =
+      NO_RETRY_EXPECTED(syscall(__NR_io_uring_setup, entries, &params));
+  if (ring_fd == -1) {
+    return nullptr;
+  }
+  IOUring* ring = new IOUring();
+  ring->ring_fd_ = ring_fd;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    delete ring;
+    return nullptr;
+  }
+
+  const size_t sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  const size_t cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const size_t rings_size = Utils::Maximum(sq_ring_size, cq_ring_size);
+  void* rings = mmap(nullptr, rings_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+  if (rings == MAP_FAILED) {
+    delete ring;
+    return nullptr;
+  }
+  ring->rings_ = rings;
+  ring->rings_size_ = rings_size;
+
+  const size_t sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    delete ring;
+    return nullptr;
+  }
+  ring->sqes_ = reinterpret_cast<struct io_uring_sqe*>(sqes);
+  ring->sqes_size_ = sqes_size;
+
+  uint8_t* base = reinterpret_cast<uint8_t*>(rings);
+  ring->sq_head_ = reinterpret_cast<uint32_t*>(base + params.sq_off.head);
+  ring->sq_tail_ = reinterpret_cast<uint32_t*>(base + params.sq_off.tail);
+  ring->sq_mask_ = *reinterpret_cast<uint32_t*>(base + params.sq_off.ring_mask);
+  ring->sq_entries_ =
+      *reinterpret_cast<uint32_t*>(base + params.sq_off.ring_entries);
+  ring->sq_array_ = reinterpret_cast<uint32_t*>(base + params.sq_off.array);
+  ring->cq_head_ = reinterpret_cast<uint32_t*>(base + params.cq_off.head);
+  ring->cq_tail_ = reinterpret_cast<uint32_t*>(base + params.cq_off.tail);
+  ring->cq_mask_ = *reinterpret_cast<uint32_t*>(base + params.cq_off.ring_mask);
+  ring->cqes_ =
+      reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+  return ring;
+}
+
+IOUring::~IOUring() {
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (rings_ != nullptr) {
+    munmap(rings_, rings_size_);
+  }
+  if (ring_fd_ != -1) {
+    close(ring_fd_);
+  }
+}
+
+struct io_uring_sqe* IOUring::NextSqe() {
+  const uint32_t tail = *sq_tail_;
+  while (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_) {
+    // The submission ring is full: hand the queued entries to the kernel
+    // without waiting for completions.
+    if (!Enter(0) && (errno != EINTR)) {
+      FATAL("io_uring submission failed: %d", errno);
+    }
+  }
+  struct io_uring_sqe* sqe = &sqes_[tail & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+void IOUring::QueueSqe() {
+  const uint32_t tail = *sq_tail_;
+  sq_array_[tail & sq_mask_] = tail & sq_mask_;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  to_submit_++;
+}
+
+void IOUring::PollAdd(int fd,
+                      uint32_t events,
+                      bool multishot,
+                      uint64_t user_data) {
+  struct io_uring_sqe* sqe = NextSqe();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  // Headers with IORING_POLL_ADD_MULTI also have poll32_events (5.9).
+  sqe->poll32_events = events;
+  sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+  sqe->user_data = user_data;
+  QueueSqe();
+}
+
+void IOUring::PollRemove(uint64_t target, uint64_t user_data) {
+  struct io_uring_sqe* sqe = NextSqe();
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = target;
+  sqe->user_data = user_data;
+  QueueSqe();
+}
+
+bool IOUring::Enter(uint32_t min_complete) {
+  const uint32_t flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+  const intptr_t result = syscall(__NR_io_uring_enter, ring_fd_, to_submit_,
+                                  min_complete, flags, nullptr, 0);
+  if (result < 0) {
+    return false;
+  }
+  ASSERT(static_cast<uint32_t>(result) <= to_submit_);
+  to_submit_ -= result;
+  return true;
+}
+
+bool IOUring::SubmitAndWait() {
+  return Enter(1);
+}
+
+void IOUring::Submit() {
+  while (to_submit_ > 0) {
+    if (!Enter(0) && (errno != EINTR)) {
+      FATAL("io_uring submission failed: %d", errno);
+    }
+  }
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HAS_IO_URING)
+
+#endif  // defined(DART_HOST_OS_LINUX)
@@ -0,0 +1,110 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_IO_URING_LINUX_H_
+#define RUNTIME_BIN_IO_URING_LINUX_H_
+
+#include "platform/globals.h"
+
+#if defined(DART_HOST_OS_LINUX) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+// The backend relies on multishot poll, which came with the UAPI headers of
+// Linux 5.13 (IORING_POLL_ADD_MULTI, IORING_FEAT_RSRC_TAGS). When building
+// against older headers, as some sysroots provide, it is compiled out and the
+// event handler always uses epoll.
+#if defined(IORING_POLL_ADD_MULTI) && defined(IORING_FEAT_RSRC_TAGS)
+#define DART_HAS_IO_URING
+#endif
+
+#if defined(DART_HAS_IO_URING)
+
+namespace dart {
+namespace bin {
+
+// A minimal io_uring instance driven through the raw system calls. The event
+// handler only uses it for readiness notification: file descriptors are
+// watched with IORING_OP_POLL_ADD instead of being registered with epoll, so
+// that every (re-)registration is queued in the submission ring and handed to
+// the kernel by the same io_uring_enter call that waits for the next batch of
+// completions.
+//
+// An IOUring is owned and used by a single thread.
+class IOUring {
+ public:
+  // Returns nullptr if the kernel does not support io_uring, or lacks the
+  // features the event handler relies upon (multishot poll, no dropped
+  // completions), or if io_uring is disabled by a seccomp policy.
+  static IOUring* Create(uint32_t entries);
+
+  ~IOUring();
+
+  // Queues a poll for [events] on [fd]. Unless [multishot] is false the poll
+  // stays armed and produces a completion, flagged with IORING_CQE_F_MORE,
+  // every time the file is woken up, much like an edge-triggered epoll
+  // registration.
+  void PollAdd(int fd, uint32_t events, bool multishot, uint64_t user_data);
+
+  // Queues the cancellation of the poll submitted with [target]. The
+  // cancellation itself completes with [user_data].
+  void PollRemove(uint64_t target, uint64_t user_data);
+
+  // Submits all queued requests and blocks until at least one completion is
+  // available. Returns false if the wait was interrupted.
+  bool SubmitAndWait();
+
+  // Submits all queued requests without waiting for completions.
+  void Submit();
+
+  // Calls [callback] for every available completion and consumes them.
+  template <typename Callback>
+  void ForEachCompletion(Callback callback) {
+    uint32_t head = *cq_head_;
+    const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+      const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      callback(cqe.user_data, cqe.res, cqe.flags);
+      head++;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+ private:
+  IOUring() {}
+
+  struct io_uring_sqe* NextSqe();
+  void QueueSqe();
+  bool Enter(uint32_t min_complete);
+
+  int ring_fd_ = -1;
+  // The submission and completion rings share one mapping
+  // (IORING_FEAT_SINGLE_MMAP).
+  void* rings_ = nullptr;
+  size_t rings_size_ = 0;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  // Number of entries queued since the last io_uring_enter.
+  uint32_t to_submit_ = 0;
+
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  struct io_uring_cqe* cqes_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUring);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HAS_IO_URING)
+
+#endif  // RUNTIME_BIN_IO_URING_LINUX_H_
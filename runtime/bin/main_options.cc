@@ -10,6 +10,7 @@
 
 #include "bin/dartdev_isolate.h"
 #include "bin/error_exit.h"
+#include "bin/eventhandler.h"
 #include "bin/file_system_watcher.h"
 #if defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/io_service_no_ssl.h"
@@ -252,6 +253,18 @@ void Options::PrintUsage() {
 "  The path to a directory that dart:io calls will treat as the root of the\n"
 "  filesystem.\n"
 #endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+"--event-handler-threads=<count>\n"
+"  The number of threads polling sockets, pipes and timers for dart:io\n"
+"  (default 1).\n"
+#endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+#if defined(DART_HOST_OS_LINUX)
+"--reuse-port-for-shared-sockets\n"
+"  Gives every isolate binding a server socket with `shared: true` its own\n"
+"  listening socket using SO_REUSEPORT, so that the kernel balances incoming\n"
+"  connections between the isolates. Connections still queued on a socket\n"
+"  when it is closed are reset.\n"
+#endif  // defined(DART_HOST_OS_LINUX)
 "\n"
 "The following options are only used for VM development and may\n"
 "be changed in any future version:\n");
@@ -489,6 +502,26 @@ bool Options::ProcessProfileMicrotasksOption(const char* arg,
   return false;
 }
 
+bool Options::ProcessEventHandlerThreadsOption(const char* arg,
+                                              CommandLineOptions* vm_options) {
+  const char* value =
+      OptionProcessor::ProcessOption(arg, "--event-handler-threads=");
+  if (value == nullptr) {
+    return false;
+  }
+  char* end;
+  const intptr_t count = strtol(value, &end, 10);
+  if ((*end != '\0') || (count < 1) || (count > EventHandler::kMaxThreads)) {
+    Syslog::PrintErr(
+        "unrecognized --event-handler-threads option syntax. "
+        "Use --event-handler-threads=<count between 1 and %" Pd ">\n",
+        EventHandler::kMaxThreads);
+    return false;
+  }
+  EventHandler::set_thread_count(count);
+  return true;
+}
+
 // Explicitly handle VM flags that can be parsed by DartDev's run command.
 bool Options::ProcessVMDebuggingOptions(const char* arg,
                                         CommandLineOptions* vm_options) {
@@ -620,6 +653,8 @@ bool Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  ListeningSocketRegistry::set_reuse_port(
+      Options::reuse_port_for_shared_sockets());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
@@ -43,6 +43,7 @@ namespace bin {
   V(trace_loading, trace_loading)                                              \
   V(short_socket_read, short_socket_read)                                      \
   V(short_socket_write, short_socket_write)                                    \
+  V(reuse_port_for_shared_sockets, reuse_port_for_shared_sockets)              \
   V(disable_exit, exit_disabled)                                               \
   V(preview_dart_2, nop_option)                                                \
   V(suppress_core_dump, suppress_core_dump)                                    \
@@ -84,6 +85,7 @@ namespace bin {
 #define CB_OPTIONS_LIST(V)                                                     \
   V(ProcessEnvironmentOption)                                                  \
   V(ProcessEnableVmServiceOption)                                              \
+  V(ProcessEventHandlerThreadsOption)                                          \
   V(ProcessObserveOption)                                                      \
   V(ProcessProfileMicrotasksOption)                                            \
   V(ProcessVMDebuggingOptions)
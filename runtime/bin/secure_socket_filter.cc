@@ -46,9 +46,11 @@ void SSLFilter::Cleanup() {
   SSLFilter::mutex_ = nullptr;
 }
 
-const intptr_t SSLFilter::kInternalBIOSize = 10 * KB;
+// The internal BIO pair is as large as the encrypted buffers. The filter is
+// created before their size is known, so this assumes the default.
+static const intptr_t kDefaultEncryptedBufferSize = 10 * KB;
 const intptr_t SSLFilter::kApproximateSize =
-    sizeof(SSLFilter) + (2 * SSLFilter::kInternalBIOSize);
+    sizeof(SSLFilter) + (2 * kDefaultEncryptedBufferSize);
 
 static SSLFilter* GetFilter(Dart_NativeArguments args) {
   SSLFilter* filter = nullptr;
@@ -276,70 +278,85 @@ CObject* SSLFilter::ProcessFilterRequest(const CObjectArray& request) {
 bool SSLFilter::ProcessAllBuffers(int starts[kNumBuffers],
                                   int ends[kNumBuffers],
                                   bool in_handshake) {
-  for (int i = 0; i < kNumBuffers; ++i) {
-    if (in_handshake && (i == kReadPlaintext || i == kWritePlaintext)) continue;
-    int start = starts[i];
-    int end = ends[i];
-    int size = IsBufferEncrypted(i) ? encrypted_buffer_size_ : buffer_size_;
-    if (start < 0 || end < 0 || start >= size || end >= size) {
-      FATAL("Out-of-bounds internal buffer access in dart:io SecureSocket");
-    }
-    switch (i) {
-      case kReadPlaintext:
-      case kWriteEncrypted:
-        // Write data to the circular buffer's free space.  If the buffer
-        // is full, neither if statement is executed and nothing happens.
-        if (start <= end) {
-          // If the free space may be split into two segments,
-          // then the first is [end, size), unless start == 0.
-          // Then, since the last free byte is at position start - 2,
-          // the interval is [end, size - 1).
-          int buffer_end = (start == 0) ? size - 1 : size;
-          int bytes = (i == kReadPlaintext)
-                          ? ProcessReadPlaintextBuffer(end, buffer_end)
-                          : ProcessWriteEncryptedBuffer(end, buffer_end);
-          if (bytes < 0) return false;
-          end += bytes;
-          ASSERT(end <= size);
-          if (end == size) end = 0;
-        }
-        if (start > end + 1) {
-          int bytes = (i == kReadPlaintext)
-                          ? ProcessReadPlaintextBuffer(end, start - 1)
-                          : ProcessWriteEncryptedBuffer(end, start - 1);
-          if (bytes < 0) return false;
-          end += bytes;
-          ASSERT(end < start);
-        }
-        ends[i] = end;
-        break;
-      case kReadEncrypted:
-      case kWritePlaintext:
-        // Read/Write data from circular buffer.  If the buffer is empty,
-        // neither if statement's condition is true.
-        if (end < start) {
-          // Data may be split into two segments.  In this case,
-          // the first is [start, size).
-          int bytes = (i == kReadEncrypted)
-                          ? ProcessReadEncryptedBuffer(start, size)
-                          : ProcessWritePlaintextBuffer(start, size);
-          if (bytes < 0) return false;
-          start += bytes;
-          ASSERT(start <= size);
-          if (start == size) start = 0;
-        }
-        if (start < end) {
-          int bytes = (i == kReadEncrypted)
-                          ? ProcessReadEncryptedBuffer(start, end)
-                          : ProcessWritePlaintextBuffer(start, end);
-          if (bytes < 0) return false;
-          start += bytes;
-          ASSERT(start <= end);
-        }
-        starts[i] = start;
-        break;
-      default:
-        UNREACHABLE();
+  // Received data is fed to the engine before decrypted data is read from it,
+  // and data to send before encrypted data is collected from it. The stages
+  // are repeated while any of them makes progress, so that a record is
+  // decrypted, or encrypted and collected, by a single request rather than by
+  // one request per stage.
+  static const BufferIndex kStages[kNumBuffers] = {
+      kReadEncrypted, kReadPlaintext, kWritePlaintext, kWriteEncrypted};
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (BufferIndex i : kStages) {
+      if (in_handshake && (i == kReadPlaintext || i == kWritePlaintext)) {
+        continue;
+      }
+      int start = starts[i];
+      int end = ends[i];
+      int size = IsBufferEncrypted(i) ? encrypted_buffer_size_ : buffer_size_;
+      if (start < 0 || end < 0 || start >= size || end >= size) {
+        FATAL("Out-of-bounds internal buffer access in dart:io SecureSocket");
+      }
+      switch (i) {
+        case kReadPlaintext:
+        case kWriteEncrypted:
+          // Write data to the circular buffer's free space.  If the buffer
+          // is full, neither if statement is executed and nothing happens.
+          if (start <= end) {
+            // If the free space may be split into two segments,
+            // then the first is [end, size), unless start == 0.
+            // Then, since the last free byte is at position start - 2,
+            // the interval is [end, size - 1).
+            int buffer_end = (start == 0) ? size - 1 : size;
+            int bytes = (i == kReadPlaintext)
+                            ? ProcessReadPlaintextBuffer(end, buffer_end)
+                            : ProcessWriteEncryptedBuffer(end, buffer_end);
+            if (bytes < 0) return false;
+            end += bytes;
+            ASSERT(end <= size);
+            if (end == size) end = 0;
+          }
+          if (start > end + 1) {
+            int bytes = (i == kReadPlaintext)
+                            ? ProcessReadPlaintextBuffer(end, start - 1)
+                            : ProcessWriteEncryptedBuffer(end, start - 1);
+            if (bytes < 0) return false;
+            end += bytes;
+            ASSERT(end < start);
+          }
+          progress = progress || (end != ends[i]);
+          ends[i] = end;
+          break;
+        case kReadEncrypted:
+        case kWritePlaintext:
+          // Read/Write data from circular buffer.  If the buffer is empty,
+          // neither if statement's condition is true.
+          if (end < start) {
+            // Data may be split into two segments.  In this case,
+            // the first is [start, size).
+            int bytes = (i == kReadEncrypted)
+                            ? ProcessReadEncryptedBuffer(start, size)
+                            : ProcessWritePlaintextBuffer(start, size);
+            if (bytes < 0) return false;
+            start += bytes;
+            ASSERT(start <= size);
+            if (start == size) start = 0;
+          }
+          if (start < end) {
+            int bytes = (i == kReadEncrypted)
+                            ? ProcessReadEncryptedBuffer(start, end)
+                            : ProcessWritePlaintextBuffer(start, end);
+            if (bytes < 0) return false;
+            start += bytes;
+            ASSERT(start <= end);
+          }
+          progress = progress || (start != starts[i]);
+          starts[i] = start;
+          break;
+        default:
+          UNREACHABLE();
+      }
     }
   }
   return true;
@@ -368,23 +385,21 @@ Dart_Handle SSLFilter::InitializeBuffers(Dart_Handle dart_this) {
   RETURN_IF_ERROR(buffers_string);
   Dart_Handle dart_buffers_object = Dart_GetField(dart_this, buffers_string);
   RETURN_IF_ERROR(dart_buffers_object);
-  Dart_Handle secure_filter_impl_type = Dart_InstanceGetType(dart_this);
-  RETURN_IF_ERROR(secure_filter_impl_type);
-  Dart_Handle size_string = DartUtils::NewString("SIZE");
+  Dart_Handle size_string = DartUtils::NewString("bufferSize");
   RETURN_IF_ERROR(size_string);
-  Dart_Handle dart_buffer_size =
-      Dart_GetField(secure_filter_impl_type, size_string);
+  Dart_Handle dart_buffer_size = Dart_GetField(dart_this, size_string);
   RETURN_IF_ERROR(dart_buffer_size);
 
   int64_t buffer_size = 0;
   Dart_Handle err = Dart_IntegerToInt64(dart_buffer_size, &buffer_size);
   RETURN_IF_ERROR(err);
 
-  Dart_Handle encrypted_size_string = DartUtils::NewString("ENCRYPTED_SIZE");
+  Dart_Handle encrypted_size_string =
+      DartUtils::NewString("encryptedBufferSize");
   RETURN_IF_ERROR(encrypted_size_string);
 
   Dart_Handle dart_encrypted_buffer_size =
-      Dart_GetField(secure_filter_impl_type, encrypted_size_string);
+      Dart_GetField(dart_this, encrypted_size_string);
   RETURN_IF_ERROR(dart_encrypted_buffer_size);
 
   int64_t encrypted_buffer_size = 0;
@@ -495,8 +510,8 @@ void SSLFilter::Connect(const char* hostname,
   int status;
   int error;
   BIO* ssl_side;
-  status = BIO_new_bio_pair(&ssl_side, kInternalBIOSize, &socket_side_,
-                            kInternalBIOSize);
+  status = BIO_new_bio_pair(&ssl_side, encrypted_buffer_size_, &socket_side_,
+                            encrypted_buffer_size_);
   SecureSocketUtils::CheckStatusSSL(status, "TlsException", "BIO_new_bio_pair",
                                     ssl_);
 
@@ -120,7 +120,6 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   }
 
  private:
-  static const intptr_t kInternalBIOSize;
   static bool library_initialized_;
   static Mutex* mutex_;  // To protect library initialization.
 
@@ -25,11 +25,31 @@ namespace bin {
 
 static constexpr int kSocketIdNativeField = 0;
 
+// Socket_Read stages reads of up to this many bytes in zone memory. This keeps
+// them within a single, cached zone segment.
+static constexpr intptr_t kScopeReadLimit = 32 * KB;
+
+// Socket_RecvFrom describes the sender of each datagram it receives by this
+// many integers: its port, the type of its address and its IPv6 scope id.
+static constexpr intptr_t kDatagramEntryLength = 3;
+
+// The maximum number of connections ServerSocket_Accept accepts at once. Keep
+// in sync with acceptBatchSize in _NativeSocket in socket_patch.dart.
+static constexpr intptr_t kMaxAcceptBatch = 16;
+
 ListeningSocketRegistry* globalTcpListeningSocketRegistry = nullptr;
 
 bool Socket::short_socket_read_ = false;
 bool Socket::short_socket_write_ = false;
 
+bool ListeningSocketRegistry::reuse_port_ = false;
+
+void ListeningSocketRegistry::set_reuse_port(bool reuse_port) {
+#if defined(DART_HOST_OS_LINUX)
+  reuse_port_ = reuse_port;
+#endif
+}
+
 void ListeningSocketRegistry::Initialize() {
   ASSERT(globalTcpListeningSocketRegistry == nullptr);
   globalTcpListeningSocketRegistry = new ListeningSocketRegistry();
@@ -127,24 +147,31 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
           return DartUtils::NewDartOSError(&os_error);
         }
 
-        // This socket creation is the exact same as the one which originally
-        // created the socket. Feed same fd and store it into native field
-        // of dart socket_object. Sockets here will share same fd but contain a
-        // different port() through EventHandler_SendData.
-        Socket* socketfd = new Socket(os_socket_same_addr->fd);
-        os_socket_same_addr->ref_count++;
-        // We set as a side-effect the file descriptor on the dart
-        // socket_object.
-        Socket::ReuseSocketIdNativeField(socket_object, socketfd,
-                                         Socket::kFinalizerListening);
-        InsertByFd(socketfd, os_socket_same_addr);
-        return Dart_True();
+        if (!os_socket_same_addr->reuse_port) {
+          // This socket creation is the exact same as the one which
+          // originally created the socket. Feed same fd and store it into
+          // native field of dart socket_object. Sockets here will share same
+          // fd but contain a different port() through EventHandler_SendData.
+          Socket* socketfd = new Socket(os_socket_same_addr->fd);
+          os_socket_same_addr->ref_count++;
+          // We set as a side-effect the file descriptor on the dart
+          // socket_object.
+          Socket::ReuseSocketIdNativeField(socket_object, socketfd,
+                                           Socket::kFinalizerListening);
+          InsertByFd(socketfd, os_socket_same_addr);
+          return Dart_True();
+        }
+        // Otherwise fall through and create another socket listening on the
+        // same (address, port), which has its own accept queue.
       }
     }
   }
 
-  // There is no socket listening on that (address, port), so we create new one.
-  intptr_t fd = ServerSocket::CreateBindListen(addr, backlog, v6_only);
+  // There is no socket listening on that (address, port) that can be reused,
+  // so we create new one.
+  const bool reuse_port = shared && reuse_port_;
+  intptr_t fd =
+      ServerSocket::CreateBindListen(addr, backlog, v6_only, reuse_port);
   if (fd == -5) {
     OSError os_error(-1, "Invalid host", OSError::kUnknown);
     return DartUtils::NewDartOSError(&os_error);
@@ -180,7 +207,8 @@ Dart_Handle ListeningSocketRegistry::CreateBindListen(Dart_Handle socket_object,
 
   Socket* socketfd = new Socket(fd);
   OSSocket* os_socket =
-      new OSSocket(addr, allocated_port, v6_only, shared, socketfd, nullptr);
+      new OSSocket(addr, allocated_port, v6_only, shared, reuse_port, socketfd,
+                   nullptr);
   os_socket->ref_count = 1;
   os_socket->next = first_os_socket;
 
@@ -262,7 +290,7 @@ Dart_Handle ListeningSocketRegistry::CreateUnixDomainBindListen(
 
   Socket* socketfd = new Socket(fd);
   OSSocket* os_socket =
-      new OSSocket(addr, -1, false, shared, socketfd, namespc);
+      new OSSocket(addr, -1, false, shared, false, socketfd, namespc);
   os_socket->ref_count = 1;
   os_socket->next = unix_domain_sockets_;
   unix_domain_sockets_ = os_socket;
@@ -538,6 +566,29 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
+    if (length <= kScopeReadLimit) {
+      // Small reads go through the native scope's zone, whose segments are
+      // recycled between calls, and the bytes read are copied into a
+      // Uint8List of the exact size on the Dart heap. This avoids the malloc
+      // and finalizer of an external buffer, as well as a second allocation
+      // on short reads.
+      uint8_t* buffer = Dart_ScopeAllocate(length);
+      intptr_t bytes_read =
+          SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+      if ((bytes_read > 0) || (bytes_read == length)) {
+        Dart_Handle result = DartUtils::MakeUint8Array(buffer, bytes_read);
+        if (Dart_IsError(result)) {
+          Dart_PropagateError(result);
+        }
+        Dart_SetReturnValue(args, result);
+      } else if (bytes_read == 0) {
+        Dart_SetReturnValue(args, Dart_Null());
+      } else {
+        ASSERT(bytes_read == -1);
+        Dart_ThrowException(DartUtils::NewDartOSError());
+      }
+      return;
+    }
     uint8_t* buffer = nullptr;
     Dart_Handle result = IOBuffer::Allocate(length, &buffer);
     if (Dart_IsNull(result)) {
@@ -582,86 +633,150 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_ReadInto)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  ASSERT(Dart_IsTypedData(buffer_obj));
+  intptr_t offset = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 2));
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  if (Socket::short_socket_read()) {
+    length = (length + 1) / 2;
+  }
+  Dart_TypedData_Type type;
+  uint8_t* buffer = nullptr;
+  intptr_t len;
+  Dart_Handle result = Dart_TypedDataAcquireData(
+      buffer_obj, &type, reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(type == Dart_TypedData_kUint8);
+  ASSERT((offset >= 0) && (length >= 0) && ((offset + length) <= len));
+  buffer += offset;
+  intptr_t bytes_read =
+      SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+  if (bytes_read >= 0) {
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetIntegerReturnValue(args, bytes_read);
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      Dart_TypedDataReleaseData(buffer_obj);
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
+  }
+}
+
 void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
   // handle 64k datagrams.
   const int kReceiveBufferLen = 65536;
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
-
-  // Ensure that a receive buffer for the UDP socket exists.
+  Dart_Handle table_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle senders_obj = Dart_GetNativeArgument(args, 2);
+  intptr_t table_length = 0;
+  ThrowIfError(Dart_ListLength(table_obj, &table_length));
+  const intptr_t count =
+      Utils::Minimum((table_length - 1) / kDatagramEntryLength,
+                     SocketBase::kMaxDatagramBatch);
+  ASSERT(count > 0);
+
+  // Ensure that a receive buffer for the UDP socket exists. It has a slot for
+  // every datagram of a batch, of which only the pages actually received into
+  // get backed by memory.
   ASSERT(socket != nullptr);
   uint8_t* recv_buffer = socket->udp_receive_buffer();
   if (recv_buffer == nullptr) {
-    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
+    recv_buffer = reinterpret_cast<uint8_t*>(
+        malloc(kReceiveBufferLen * SocketBase::kMaxDatagramBatch));
     socket->set_udp_receive_buffer(recv_buffer);
   }
 
-  // Read data into the buffer.
-  RawAddr addr;
-  const intptr_t bytes_read = SocketBase::RecvFrom(
-      socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
-  if (bytes_read == 0) {
+  // Read the available datagrams, up to count, into the buffer.
+  SocketBase::ReceivedDatagram datagrams[SocketBase::kMaxDatagramBatch];
+  const intptr_t received =
+      SocketBase::RecvFromBatch(socket->fd(), recv_buffer, kReceiveBufferLen,
+                                datagrams, count, SocketBase::kAsync);
+  if (received == 0) {
     Dart_SetReturnValue(args, Dart_Null());
     return;
   }
-  if (bytes_read < 0) {
-    ASSERT(bytes_read == -1);
+  if (received < 0) {
+    ASSERT(received == -1);
     Dart_ThrowException(DartUtils::NewDartOSError());
   }
 
-  // Datagram data read. Copy into buffer of the exact size,
-  ASSERT(bytes_read >= 0);
-  uint8_t* data_buffer = nullptr;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
-  if (Dart_IsNull(data)) {
-    Dart_ThrowException(DartUtils::NewDartOSError());
+  // Datagrams read. Copy each into a buffer of the exact size. The result
+  // holds the data of each datagram followed by its sender's address as a
+  // string if it has a scope id, or null. The raw bytes of the senders'
+  // addresses go to the senders list, at a stride of sizeof(in6_addr).
+  Dart_Handle result = ThrowIfError(Dart_NewList(2 * received));
+  int64_t table[1 + kDatagramEntryLength * SocketBase::kMaxDatagramBatch];
+  uint8_t senders[sizeof(in6_addr) * SocketBase::kMaxDatagramBatch];
+  table[0] = received;
+  for (intptr_t i = 0; i < received; i++) {
+    RawAddr& addr = datagrams[i].addr;
+    const intptr_t length = datagrams[i].length;
+    uint8_t* data_buffer = nullptr;
+    Dart_Handle data = IOBuffer::Allocate(length, &data_buffer);
+    if (Dart_IsNull(data)) {
+      Dart_ThrowException(DartUtils::NewDartOSError());
+    }
+    if (Dart_IsError(data)) {
+      Dart_PropagateError(data);
+    }
+    ASSERT(data_buffer != nullptr);
+    memmove(data_buffer, recv_buffer + i * kReceiveBufferLen, length);
+    ThrowIfError(Dart_ListSetAt(result, 2 * i, data));
+
+    int64_t* entry = &table[1 + i * kDatagramEntryLength];
+    entry[0] = SocketAddress::GetAddrPort(addr);
+    uint8_t* sender = &senders[i * sizeof(in6_addr)];
+    // TODO(21403): Add checks for AF_UNIX, if unix domain sockets
+    // are used in SOCK_DGRAM.
+    if (addr.addr.sa_family == AF_INET) {
+      entry[1] = SocketAddress::TYPE_IPV4;
+      entry[2] = 0;
+      memmove(sender, &addr.in.sin_addr, sizeof(in_addr));
+    } else {
+      ASSERT(addr.addr.sa_family == AF_INET6);
+      entry[1] = SocketAddress::TYPE_IPV6;
+      entry[2] = addr.in6.sin6_scope_id;
+      memmove(sender, &addr.in6.sin6_addr, sizeof(in6_addr));
+      if (addr.in6.sin6_scope_id != 0) {
+        // Format the address, including its scope, using the numeric format.
+        addr.in6.sin6_port = 0;
+        char numeric_address[INET6_ADDRSTRLEN];
+        SocketBase::FormatNumericAddress(addr, numeric_address,
+                                         INET6_ADDRSTRLEN);
+        ThrowIfError(Dart_ListSetAt(
+            result, 2 * i + 1,
+            ThrowIfError(Dart_NewStringFromCString(numeric_address))));
+      }
+    }
   }
-  if (Dart_IsError(data)) {
-    Dart_PropagateError(data);
-  }
-  ASSERT(data_buffer != nullptr);
-  memmove(data_buffer, recv_buffer, bytes_read);
-
-  // Get the port and clear it in the sockaddr structure.
-  int port = SocketAddress::GetAddrPort(addr);
-  // TODO(21403): Add checks for AF_UNIX, if unix domain sockets
-  // are used in SOCK_DGRAM.
-  enum internet_type { IPv4, IPv6 };
-  internet_type type;
-  if (addr.addr.sa_family == AF_INET) {
-    addr.in.sin_port = 0;
-    type = IPv4;
-  } else {
-    ASSERT(addr.addr.sa_family == AF_INET6);
-    addr.in6.sin6_port = 0;
-    type = IPv6;
-  }
-  // Format the address to a string using the numeric format.
-  char numeric_address[INET6_ADDRSTRLEN];
-  SocketBase::FormatNumericAddress(addr, numeric_address, INET6_ADDRSTRLEN);
-
-  // Create a Datagram object with the data and sender address and port.
-  const int kNumArgs = 5;
-  Dart_Handle dart_args[kNumArgs];
-  dart_args[0] = data;
-  dart_args[1] = Dart_NewStringFromCString(numeric_address);
-  if (Dart_IsError(dart_args[1])) {
-    Dart_PropagateError(dart_args[1]);
-  }
-  dart_args[2] = SocketAddress::ToTypedData(addr);
-  dart_args[3] = Dart_NewInteger(port);
-  dart_args[4] = Dart_NewInteger(type);
-  if (Dart_IsError(dart_args[3])) {
-    Dart_PropagateError(dart_args[3]);
-  }
-  // TODO(sgjesse): Cache the _makeDatagram function somewhere.
-  Dart_Handle io_lib = Dart_LookupLibrary(DartUtils::NewString("dart:io"));
-  if (Dart_IsError(io_lib)) {
-    Dart_PropagateError(io_lib);
-  }
-  Dart_Handle result = Dart_Invoke(
-      io_lib, DartUtils::NewString("_makeDatagram"), kNumArgs, dart_args);
+
+  Dart_TypedData_Type type;
+  int64_t* table_data = nullptr;
+  intptr_t len;
+  ThrowIfError(Dart_TypedDataAcquireData(
+      table_obj, &type, reinterpret_cast<void**>(&table_data), &len));
+  ASSERT(type == Dart_TypedData_kInt64);
+  memmove(table_data, table,
+          (1 + received * kDatagramEntryLength) * sizeof(int64_t));
+  Dart_TypedDataReleaseData(table_obj);
+  uint8_t* senders_data = nullptr;
+  ThrowIfError(Dart_TypedDataAcquireData(
+      senders_obj, &type, reinterpret_cast<void**>(&senders_data), &len));
+  ASSERT(type == Dart_TypedData_kUint8);
+  ASSERT(len >= received * static_cast<intptr_t>(sizeof(in6_addr)));
+  memmove(senders_data, senders, received * sizeof(in6_addr));
+  Dart_TypedDataReleaseData(senders_obj);
   Dart_SetReturnValue(args, result);
 }
 
@@ -782,6 +897,108 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_WriteVector)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  // List of triples <buffer, offset, length> arranged to minimize dart api
+  // use in native methods.
+  Dart_Handle list = Dart_GetNativeArgument(args, 1);
+  ASSERT(Dart_IsList(list));
+  intptr_t list_length;
+  ThrowIfError(Dart_ListLength(list, &list_length));
+  const intptr_t count = list_length / 3;
+  ASSERT((count * 3) == list_length);
+  ASSERT(count <= SocketBase::kMaxIOVectors);
+  Dart_Handle* items = reinterpret_cast<Dart_Handle*>(
+      Dart_ScopeAllocate(list_length * sizeof(Dart_Handle)));
+  ThrowIfError(Dart_ListGetRange(list, 0, list_length, items));
+
+  SocketBase::IOVector* vectors = reinterpret_cast<SocketBase::IOVector*>(
+      Dart_ScopeAllocate(count * sizeof(SocketBase::IOVector)));
+  intptr_t num_bytes = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    vectors[i].length = DartUtils::GetIntptrValue(items[i * 3 + 2]);
+    num_bytes += vectors[i].length;
+  }
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (num_bytes > 1) {
+      short_write = true;
+    }
+    // Trim the buffers to the first half of the bytes.
+    intptr_t budget = (num_bytes + 1) / 2;
+    for (intptr_t i = 0; i < count; i++) {
+      vectors[i].length = Utils::Minimum(vectors[i].length, budget);
+      budget -= vectors[i].length;
+    }
+  }
+
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_TypedData_Type type;
+    uint8_t* buffer = nullptr;
+    intptr_t len;
+    Dart_Handle result = Dart_TypedDataAcquireData(
+        items[i * 3], &type, reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      for (intptr_t j = 0; j < i; j++) {
+        Dart_TypedDataReleaseData(items[j * 3]);
+      }
+      Dart_PropagateError(result);
+    }
+    intptr_t offset = DartUtils::GetIntptrValue(items[i * 3 + 1]);
+    ASSERT((offset + vectors[i].length) <= len);
+    vectors[i].data = buffer + offset;
+  }
+  intptr_t bytes_written =
+      SocketBase::WriteVector(socket->fd(), vectors, count, SocketBase::kAsync);
+  if (bytes_written >= 0) {
+    for (intptr_t i = 0; i < count; i++) {
+      Dart_TypedDataReleaseData(items[i * 3]);
+    }
+    if (short_write) {
+      // If the write was forced 'short', indicate by returning the negative
+      // number of bytes. A forced short write may not trigger a write event.
+      Dart_SetIntegerReturnValue(args, -bytes_written);
+    } else {
+      Dart_SetIntegerReturnValue(args, bytes_written);
+    }
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      for (intptr_t i = 0; i < count; i++) {
+        Dart_TypedDataReleaseData(items[i * 3]);
+      }
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
+  }
+}
+
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  intptr_t file_fd = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1));
+  int64_t offset = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 2), 0, kMaxInt64);
+  int64_t length = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 3), 0, kMaxInt64);
+  int64_t bytes_sent = SocketBase::SendFile(socket->fd(), file_fd, offset,
+                                            length, SocketBase::kAsync);
+  if (bytes_sent >= 0) {
+    Dart_SetIntegerReturnValue(args, bytes_sent);
+  } else {
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  }
+#else
+  Dart_SetReturnValue(args,
+                      DartUtils::NewDartUnsupportedError(
+                          "This is not supported on this operating system"));
+#endif
+}
+
 void FUNCTION_NAME(Socket_SendMessage)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -1041,17 +1258,35 @@ void FUNCTION_NAME(ServerSocket_CreateUnixDomainBindListen)(
 #endif  // defined(DART_HOST_OS_WINDOWS)
 }
 
+// Accepts pending connections, up to the length of the Int64List passed, and
+// stores their ids in it. Returns the number of connections accepted.
 void FUNCTION_NAME(ServerSocket_Accept)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
-  intptr_t new_socket = ServerSocket::Accept(socket->fd());
-  if (new_socket >= 0) {
-    Socket::SetSocketIdNativeField(Dart_GetNativeArgument(args, 1), new_socket,
-                                   Socket::kFinalizerNormal);
-    Dart_SetReturnValue(args, Dart_True());
-  } else {
-    Dart_SetReturnValue(args, Dart_False());
-  }
+  Dart_Handle ids_obj = Dart_GetNativeArgument(args, 1);
+  intptr_t ids_length = 0;
+  ThrowIfError(Dart_ListLength(ids_obj, &ids_length));
+  const intptr_t count = Utils::Minimum(ids_length, kMaxAcceptBatch);
+  int64_t ids[kMaxAcceptBatch];
+  intptr_t accepted = 0;
+  while (accepted < count) {
+    intptr_t new_socket = ServerSocket::Accept(socket->fd());
+    if (new_socket < 0) {
+      break;
+    }
+    ids[accepted++] = new_socket;
+  }
+  if (accepted > 0) {
+    Dart_TypedData_Type type;
+    int64_t* ids_data = nullptr;
+    intptr_t len;
+    ThrowIfError(Dart_TypedDataAcquireData(
+        ids_obj, &type, reinterpret_cast<void**>(&ids_data), &len));
+    ASSERT(type == Dart_TypedData_kInt64);
+    memmove(ids_data, ids, accepted * sizeof(int64_t));
+    Dart_TypedDataReleaseData(ids_obj);
+  }
+  Dart_SetIntegerReturnValue(args, accepted);
 }
 
 CObject* Socket::LookupRequest(const CObjectArray& request) {
@@ -5,6 +5,8 @@
 #ifndef RUNTIME_BIN_SOCKET_H_
 #define RUNTIME_BIN_SOCKET_H_
 
+#include <atomic>
+
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
 #include "bin/file.h"
@@ -66,6 +68,15 @@ class Socket : public ReferenceCounted<Socket> {
   uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
   void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
 
+  // The event handler thread this socket's messages go to, or -1 before the
+  // first message. See EventHandler::HandlerFor.
+  intptr_t event_handler_index() const {
+    return event_handler_index_.load(std::memory_order_relaxed);
+  }
+  void set_event_handler_index(intptr_t index) {
+    event_handler_index_.store(index, std::memory_order_relaxed);
+  }
+
   static bool Initialize();
 
   // Creates a socket which is bound and connected. The port to connect to is
@@ -128,6 +139,7 @@ class Socket : public ReferenceCounted<Socket> {
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
+  std::atomic<intptr_t> event_handler_index_ = {-1};
 
   friend class ReferenceCounted<Socket>;
   DISALLOW_COPY_AND_ASSIGN(Socket);
@@ -142,6 +154,10 @@ class ServerSocket {
   // Creates a socket which is bound and listens. The port to listen on is
   // specified in the port component of the passed RawAddr structure.
   //
+  // If [reuse_port] is true, SO_REUSEPORT is set before binding so that
+  // several sockets can listen on the same address. It is only supported on
+  // Linux.
+  //
   // Returns a positive integer if the call is successful. In case of failure
   // it returns:
   //
@@ -149,7 +165,8 @@ class ServerSocket {
   //   -5: invalid bindAddress
   static intptr_t CreateBindListen(const RawAddr& addr,
                                    intptr_t backlog,
-                                   bool v6_only = false);
+                                   bool v6_only = false,
+                                   bool reuse_port = false);
   static intptr_t CreateUnixDomainBindListen(const RawAddr& addr,
                                              intptr_t backlog);
 
@@ -209,12 +226,20 @@ class ListeningSocketRegistry {
 
   Mutex* mutex() { return &mutex_; }
 
+  // If set, every isolate binding a shared socket gets its own listening
+  // socket with SO_REUSEPORT instead of a reference to a single one, and the
+  // kernel balances incoming connections between them. Only has an effect on
+  // Linux.
+  static bool reuse_port() { return reuse_port_; }
+  static void set_reuse_port(bool reuse_port);
+
  private:
   struct OSSocket {
     RawAddr address;
     int port;
     bool v6_only;
     bool shared;
+    bool reuse_port;
     int ref_count;
     intptr_t fd;
 
@@ -230,12 +255,14 @@ class ListeningSocketRegistry {
              int port,
              bool v6_only,
              bool shared,
+             bool reuse_port,
              Socket* socketfd,
              Namespace* namespc)
         : address(address),
           port(port),
           v6_only(v6_only),
           shared(shared),
+          reuse_port(reuse_port),
           ref_count(0),
           namespc(namespc),
           next(nullptr) {
@@ -314,6 +341,8 @@ class ListeningSocketRegistry {
 
   Mutex mutex_;
 
+  static bool reuse_port_;
+
   DISALLOW_COPY_AND_ASSIGN(ListeningSocketRegistry);
 };
 
@@ -347,5 +347,41 @@ intptr_t SocketBase::Write(intptr_t fd,
 }
 #endif
 
+#if !defined(DART_HOST_OS_LINUX) && !defined(DART_HOST_OS_ANDROID)
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   uint8_t* buffer,
+                                   intptr_t slot_size,
+                                   ReceivedDatagram* datagrams,
+                                   intptr_t count,
+                                   SocketOpKind sync) {
+  ASSERT((count > 0) && (count <= kMaxDatagramBatch));
+  intptr_t result = RecvFrom(fd, buffer, slot_size, &datagrams[0].addr, sync);
+  if (result <= 0) {
+    return result;
+  }
+  datagrams[0].length = result;
+  return 1;
+}
+
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const IOVector* vectors,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  ASSERT(count <= kMaxIOVectors);
+  intptr_t written_bytes = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t result = Write(fd, vectors[i].data, vectors[i].length, sync);
+    if (result == -1) {
+      return -1;  // Error occurred.
+    }
+    written_bytes += result;
+    if (result < vectors[i].length) {
+      break;
+    }
+  }
+  return written_bytes;
+}
+#endif
+
 }  // namespace bin
 }  // namespace dart
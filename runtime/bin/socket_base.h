@@ -197,6 +197,33 @@ class SocketBase : public AllStatic {
                         intptr_t num_bytes,
                         SocketOpKind sync);
 
+  // A buffer passed to WriteVector.
+  struct IOVector {
+    const void* data;
+    intptr_t length;
+  };
+  static constexpr intptr_t kMaxIOVectors = 64;
+
+  // Writes up to kMaxIOVectors buffers as if they were concatenated, using a
+  // single vectored write where the platform supports it. Returns the total
+  // number of bytes written, which may end in the middle of a buffer.
+  static intptr_t WriteVector(intptr_t fd,
+                              const IOVector* vectors,
+                              intptr_t count,
+                              SocketOpKind sync);
+
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  // Sends up to num_bytes bytes of the file file_fd, starting at offset, to
+  // the socket without copying them through user space. Returns the number
+  // of bytes sent, which is less than num_bytes if the socket would block or
+  // the end of the file was reached.
+  static int64_t SendFile(intptr_t fd,
+                          intptr_t file_fd,
+                          int64_t offset,
+                          int64_t num_bytes,
+                          SocketOpKind sync);
+#endif
+
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
   // used for datagram sockets.
@@ -217,6 +244,28 @@ class SocketBase : public AllStatic {
                            intptr_t num_bytes,
                            RawAddr* addr,
                            SocketOpKind sync);
+
+  // A datagram received by RecvFromBatch.
+  struct ReceivedDatagram {
+    RawAddr addr;
+    intptr_t length;
+  };
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  static constexpr intptr_t kMaxDatagramBatch = 8;
+#else
+  static constexpr intptr_t kMaxDatagramBatch = 1;
+#endif
+
+  // Receives up to count datagrams, at most kMaxDatagramBatch, using a single
+  // system call where the platform supports it. Datagram i is received into
+  // the slot_size bytes at buffer + i * slot_size. Returns the number of
+  // datagrams received, 0 if none were available, or -1 on error.
+  static intptr_t RecvFromBatch(intptr_t fd,
+                                uint8_t* buffer,
+                                intptr_t slot_size,
+                                ReceivedDatagram* datagrams,
+                                intptr_t count,
+                                SocketOpKind sync);
   static intptr_t ReceiveMessage(intptr_t fd,
                                  void* buffer,
                                  int64_t* p_buffer_num_bytes,
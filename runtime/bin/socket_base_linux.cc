@@ -7,15 +7,17 @@
 
 #include "bin/socket_base.h"
 
-#include <errno.h>        // NOLINT
-#include <ifaddrs.h>      // NOLINT
-#include <net/if.h>       // NOLINT
-#include <netinet/tcp.h>  // NOLINT
-#include <stdio.h>        // NOLINT
-#include <stdlib.h>       // NOLINT
-#include <string.h>       // NOLINT
-#include <sys/stat.h>     // NOLINT
-#include <unistd.h>       // NOLINT
+#include <errno.h>         // NOLINT
+#include <ifaddrs.h>       // NOLINT
+#include <net/if.h>        // NOLINT
+#include <netinet/tcp.h>   // NOLINT
+#include <stdio.h>         // NOLINT
+#include <stdlib.h>        // NOLINT
+#include <string.h>        // NOLINT
+#include <sys/sendfile.h>  // NOLINT
+#include <sys/stat.h>      // NOLINT
+#include <sys/uio.h>       // NOLINT
+#include <unistd.h>        // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
@@ -35,6 +37,114 @@ void SocketBase::GetError(intptr_t fd, OSError* os_error) {
   os_error->SetCodeAndMessage(OSError::kSystem, errno);
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const IOVector* vectors,
+                                 intptr_t count,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT(count <= kMaxIOVectors);
+  struct iovec iov[kMaxIOVectors];
+  intptr_t num_bytes = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(vectors[i].data);
+    iov[i].iov_len = vectors[i].length;
+    num_bytes += vectors[i].length;
+  }
+  // As in Write, write as many bytes as possible so that the edge-triggered
+  // event handler is guaranteed to see the socket become writable again.
+  struct iovec* next = iov;
+  intptr_t num_vectors_left = count;
+  intptr_t written_bytes = 0;
+  while (written_bytes < num_bytes) {
+    ssize_t result = TEMP_FAILURE_RETRY(writev(fd, next, num_vectors_left));
+    static_assert(EAGAIN == EWOULDBLOCK);
+    if (result == -1) {
+      if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+        break;
+      }
+      return -1;  // Error occurred.
+    }
+    written_bytes += result;
+    // Skip the buffers that were written completely and advance into the one
+    // that was written partially.
+    while ((num_vectors_left > 0) &&
+           (static_cast<size_t>(result) >= next->iov_len)) {
+      result -= next->iov_len;
+      next++;
+      num_vectors_left--;
+    }
+    if (num_vectors_left > 0) {
+      next->iov_base = static_cast<uint8_t*>(next->iov_base) + result;
+      next->iov_len -= result;
+    }
+  }
+  return written_bytes;
+}
+
+int64_t SocketBase::SendFile(intptr_t fd,
+                             intptr_t file_fd,
+                             int64_t offset,
+                             int64_t num_bytes,
+                             SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT((offset >= 0) && (num_bytes >= 0));
+  // As in Write, send as many bytes as possible so that the edge-triggered
+  // event handler is guaranteed to see the socket become writable again.
+  off64_t position = offset;
+  int64_t num_bytes_left = num_bytes;
+  while (num_bytes_left > 0) {
+    // Loop to ensure we send everything, and not only up to 2GB.
+    const size_t count = Utils::Minimum<int64_t>(num_bytes_left, kMaxInt32);
+    ssize_t result =
+        TEMP_FAILURE_RETRY(sendfile64(fd, file_fd, &position, count));
+    static_assert(EAGAIN == EWOULDBLOCK);
+    if (result == -1) {
+      if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+        break;
+      }
+      return -1;  // Error occurred.
+    }
+    if (result == 0) {
+      break;  // End of file.
+    }
+    num_bytes_left -= result;
+  }
+  return num_bytes - num_bytes_left;
+}
+
+intptr_t SocketBase::RecvFromBatch(intptr_t fd,
+                                   uint8_t* buffer,
+                                   intptr_t slot_size,
+                                   ReceivedDatagram* datagrams,
+                                   intptr_t count,
+                                   SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT((count > 0) && (count <= kMaxDatagramBatch));
+  struct mmsghdr messages[kMaxDatagramBatch];
+  struct iovec vectors[kMaxDatagramBatch];
+  memset(messages, 0, sizeof(messages));
+  for (intptr_t i = 0; i < count; i++) {
+    vectors[i].iov_base = buffer + i * slot_size;
+    vectors[i].iov_len = slot_size;
+    messages[i].msg_hdr.msg_name = &datagrams[i].addr.ss;
+    messages[i].msg_hdr.msg_namelen = sizeof(datagrams[i].addr.ss);
+    messages[i].msg_hdr.msg_iov = &vectors[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  int received =
+      TEMP_FAILURE_RETRY(recvmmsg(fd, messages, count, 0, nullptr));
+  if (received == -1) {
+    if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+      return 0;
+    }
+    return -1;  // Error occurred.
+  }
+  for (intptr_t i = 0; i < received; i++) {
+    datagrams[i].length = messages[i].msg_len;
+  }
+  return received;
+}
+
 int SocketBase::GetType(intptr_t fd) {
   struct stat64 buf;
   int result = TEMP_FAILURE_RETRY(fstat64(fd, &buf));
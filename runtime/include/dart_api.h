@@ -1178,6 +1178,24 @@ DART_EXPORT Dart_IsolateGroupId Dart_CurrentIsolateGroupId(void);
  */
 DART_EXPORT void* Dart_IsolateGroupData(Dart_Isolate isolate);
 
+/**
+ * Sets the number of isolates the current isolate group keeps created ahead
+ * of time for Isolate.spawn, so that spawning an isolate does not need to
+ * wait for its creation. The pool is refilled after each spawn that takes
+ * an isolate from it.
+ *
+ * Pooled isolates are created with the isolate initialization callback
+ * (see Dart_InitializeParams.initialize_isolate) and are visible to tooling
+ * before they are spawned. A size of 0, the default unless set by the
+ * --isolate_spawn_pool_size flag, disables the pool. Pooled isolates beyond
+ * a lowered size are shut down.
+ *
+ * Requires there to be a current isolate.
+ *
+ * \param size The number of isolates to keep in the pool.
+ */
+DART_EXPORT void Dart_SetIsolateSpawnPoolSize(intptr_t size);
+
 /**
  * Returns the debugging name for the current isolate.
  *
@@ -1361,6 +1379,86 @@ typedef enum {
 DART_EXPORT Dart_PerformanceMode
 Dart_SetPerformanceMode(Dart_PerformanceMode mode);
 
+/**
+ * Sets goals for the garbage collector of the current isolate group.
+ *
+ * The collector tries to meet them by adjusting the size of the new
+ * generation, how early concurrent marking starts and how much the incremental
+ * compactor evacuates at once. These are goals, not guarantees.
+ *
+ * \param max_pause_micros The desired upper bound on a single stop-the-world
+ *   pause in microseconds, or 0 for no goal.
+ * \param max_gc_time_percent The desired upper bound on the percentage of time
+ *   spent in garbage collection, or 0 for the default.
+ *
+ * Requires a current isolate and API scope.
+ *
+ * \return An error handle if max_pause_micros is negative or
+ *   max_gc_time_percent is outside [0, 100], and a valid handle otherwise.
+ */
+DART_EXPORT Dart_Handle Dart_SetGCGoals(int64_t max_pause_micros,
+                                        intptr_t max_gc_time_percent);
+
+/**
+ * The number of buckets in a Dart_GCHistogram. Bucket 0 counts samples under
+ * 1 microsecond, bucket i counts samples in [2^(i-1), 2^i) microseconds, and
+ * the last bucket also counts all longer samples.
+ */
+#define DART_GC_HISTOGRAM_BUCKETS 24
+
+typedef struct {
+  int64_t count;
+  int64_t total_micros;
+  int64_t max_micros;
+  int64_t buckets[DART_GC_HISTOGRAM_BUCKETS];
+} Dart_GCHistogram;
+
+/**
+ * Why a collection happened. Indexes Dart_GCStatistics::pauses.
+ */
+typedef enum {
+  Dart_GCReason_NewSpace = 0,
+  Dart_GCReason_StoreBuffer,
+  Dart_GCReason_Promotion,
+  Dart_GCReason_OldSpace,
+  Dart_GCReason_Finalize,
+  Dart_GCReason_Full,
+  Dart_GCReason_External,
+  Dart_GCReason_Idle,
+  Dart_GCReason_Destroyed,
+  Dart_GCReason_Debugging,
+  Dart_GCReason_CatchUp,
+  Dart_GCReason_Count,
+} Dart_GCReason;
+
+typedef struct {
+  /** Stop-the-world pauses, by the reason for the collection. */
+  Dart_GCHistogram pauses[Dart_GCReason_Count];
+  /** Wall time from starting concurrent marking to finalizing it. */
+  Dart_GCHistogram concurrent_mark;
+  /** Wall time of each concurrent sweep. */
+  Dart_GCHistogram concurrent_sweep;
+  /** Total bytes promoted from the new generation. */
+  int64_t promoted_bytes;
+  /** Scavenges forced by the store buffer overflowing. */
+  int64_t store_buffer_overflows;
+  /** Old generation pages still waiting to be swept. */
+  int64_t unswept_pages;
+} Dart_GCStatistics;
+
+/**
+ * Reads the garbage collection statistics of the current isolate group.
+ *
+ * The statistics are always collected and are cumulative since the isolate
+ * group started, so they can be sampled periodically without enabling the
+ * timeline.
+ *
+ * \param statistics Filled in with the current statistics.
+ *
+ * Requires a current isolate.
+ */
+DART_EXPORT void Dart_GetGCStatistics(Dart_GCStatistics* statistics);
+
 /**
  * Starts the CPU sampling profiler.
  */
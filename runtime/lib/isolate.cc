@@ -26,6 +26,7 @@
 #include "vm/port.h"
 #include "vm/resolver.h"
 #include "vm/service.h"
+#include "vm/service_event.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
 
@@ -64,6 +65,17 @@ DEFINE_NATIVE_ENTRY(RawReceivePort_factory, 0, 2) {
   return isolate->CreateReceivePort(debug_name);
 }
 
+DEFINE_NATIVE_ENTRY(RawReceivePort_factoryBounded, 0, 4) {
+  ASSERT(
+      TypeArguments::CheckedHandle(zone, arguments->NativeArgAt(0)).IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, debug_name, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, capacity, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, block_senders, arguments->NativeArgAt(3));
+  ASSERT(capacity.Value() > 0);
+  return isolate->CreateReceivePort(debug_name, capacity.Value(),
+                                    block_senders.value());
+}
+
 DEFINE_NATIVE_ENTRY(RawReceivePort_get_id, 0, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(ReceivePort, port, arguments->NativeArgAt(0));
   return Integer::New(port.Id());
@@ -107,6 +119,11 @@ static bool InSameGroup(IsolateGroup* sender, const SendPort& receiver) {
   return sender->id() == receiver.origin_id();
 }
 
+// The longest a sender waiting for room in a full port sleeps between
+// attempts to post its message. Keep in sync with the documentation of
+// RawReceivePort.bounded in sdk/lib/isolate/isolate.dart.
+static constexpr intptr_t kMaxBlockedSendSleepMicros = 1000;
+
 DEFINE_NATIVE_ENTRY(SendPort_sendInternal_, 0, 2) {
   GET_NON_NULL_NATIVE_ARGUMENT(SendPort, port, arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(Instance, obj, arguments->NativeArgAt(1));
@@ -121,9 +138,40 @@ DEFINE_NATIVE_ENTRY(SendPort_sendInternal_, 0, 2) {
   }
 #endif
 
-  // TODO(turnidge): Throw an exception when the return value is false?
-  PortMap::PostMessage(WriteMessage(same_group, obj, destination_port_id,
-                                    Message::kNormalPriority));
+  std::unique_ptr<Message> message = WriteMessage(
+      same_group, obj, destination_port_id, Message::kNormalPriority);
+  // TODO(turnidge): Throw an exception when the port is closed?
+  PortMap::PostResult result = PortMap::TryPostMessage(&message);
+  if (result == PortMap::PostResult::kBusy &&
+      !PortMap::IsOwnedByCurrentThread(destination_port_id)) {
+    // Wait for the receiver to make room. This isolate stays responsive to
+    // interrupts, e.g. to be killed, while it waits.
+    intptr_t sleep_micros = 1;
+    do {
+      {
+        TransitionVMToBlocked transition(thread);
+        OS::SleepMicros(sleep_micros);
+      }
+      sleep_micros = Utils::Minimum<intptr_t>(2 * sleep_micros,
+                                              kMaxBlockedSendSleepMicros);
+      const Error& error = Error::Handle(zone, thread->HandleInterrupts());
+      if (!error.IsNull()) {
+        message->DropFinalizers();
+        message.reset();
+        Exceptions::PropagateError(error);
+      }
+      result = PortMap::TryPostMessage(&message);
+    } while (result == PortMap::PostResult::kBusy);
+  }
+  if (result == PortMap::PostResult::kFull ||
+      result == PortMap::PostResult::kBusy) {
+    // The receiver is full, or it is this isolate, which cannot make room
+    // while the sender waits.
+    message->DropFinalizers();
+    message.reset();
+    Exceptions::ThrowStateError(String::Handle(
+        zone, String::New("Cannot send to a full bounded receive port")));
+  }
   return Object::null();
 }
 
@@ -836,33 +884,86 @@ class SpawnIsolateTask : public ThreadPool::Task {
       return;
     }
 
-    char* error = nullptr;
-
     auto group = state_->isolate_group();
-    Isolate* isolate = CreateWithinExistingIsolateGroup(group, name, &error);
-    parent_isolate_->DecrementSpawnCount();
-    parent_isolate_ = nullptr;
+    Isolate* isolate = group->TakePooledIsolate();
+    if (isolate != nullptr) {
+      Dart_EnterIsolate(Api::CastIsolate(isolate));
+      Rename(isolate, name);
+    } else {
+      char* error = nullptr;
+      isolate = CreateLightweight(group, name, &error);
+      if (isolate == nullptr) {
+        const bool has_current_isolate = Isolate::Current() != nullptr;
+        FailedSpawn(error, has_current_isolate);
+        if (has_current_isolate) {
+          Dart_ShutdownIsolate();
+        }
+        free(error);
+        return;
+      }
+    }
 
+    Run(isolate);
+
+    // The parent's outstanding spawn keeps the group alive until the pool is
+    // refilled, after which the destructor releases it.
+    FillPool(group);
+  }
+
+ private:
+  // Creates and initializes an isolate in [group] and leaves it entered. On
+  // failure, returns nullptr and leaves the isolate, if it was created,
+  // entered for the caller to shut down.
+  static Isolate* CreateLightweight(IsolateGroup* group,
+                                    const char* name,
+                                    char** error) {
+    Isolate* isolate = CreateWithinExistingIsolateGroup(group, name, error);
     if (isolate == nullptr) {
-      FailedSpawn(error, /*has_current_isolate=*/false);
-      free(error);
-      return;
+      return nullptr;
     }
-
     void* child_isolate_data = nullptr;
-    const bool success = initialize_callback(&child_isolate_data, &error);
-    if (!success) {
-      FailedSpawn(error);
-      Dart_ShutdownIsolate();
-      free(error);
-      return;
+    if (!Isolate::InitializeCallback()(&child_isolate_data, error)) {
+      return nullptr;
     }
-
     isolate->set_init_callback_data(child_isolate_data);
-    Run(isolate);
+    return isolate;
+  }
+
+  // Replaces the placeholder name under which tooling has seen a pooled
+  // isolate.
+  static void Rename(Isolate* isolate, const char* name) {
+    isolate->set_name(name);
+#if !defined(PRODUCT)
+    if (Service::isolate_stream.enabled()) {
+      TransitionNativeToVM transition(Thread::Current());
+      ServiceEvent event(isolate, ServiceEvent::kIsolateUpdate);
+      Service::HandleEvent(&event);
+    }
+#endif  // !defined(PRODUCT)
+  }
+
+  static void FillPool(IsolateGroup* group) {
+    ASSERT(Isolate::Current() == nullptr);
+    for (intptr_t i = group->IsolatePoolDeficit(); i > 0; i--) {
+      char* error = nullptr;
+      Isolate* isolate = CreateLightweight(group, "pooled-isolate", &error);
+      if (isolate == nullptr) {
+        // Isolate creation may be disabled because the VM is shutting down.
+        if (Isolate::Current() != nullptr) {
+          Dart_ShutdownIsolate();
+        }
+        free(error);
+        return;
+      }
+      Dart_ExitIsolate();
+      if (!group->AddPooledIsolate(isolate)) {
+        Dart_EnterIsolate(Api::CastIsolate(isolate));
+        Dart_ShutdownIsolate();
+        return;
+      }
+    }
   }
 
- private:
   void Run(Isolate* child) {
     if (!EnsureIsRunnable(child)) {
       Dart_ShutdownIsolate();
@@ -0,0 +1,151 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--object-copy-helper-threads=3
+// VMOptions=--object-copy-helper-threads=3 --preserve-hashes-in-object-copy
+// VMOptions=--object-copy-helper-threads=3 --preserve-hashes-in-object-copy --gc-on-foc-slow-path --force-evacuation --verify-store-buffer
+// VMOptions=--no-enable-fast-object-copy --preserve-hashes-in-object-copy
+
+// Tests copying large arrays and typed data with helper threads, and copying
+// maps and sets whose keys keep their identity hash codes.
+
+import 'dart:async';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+class Key {
+  final int value;
+  Key(this.value);
+}
+
+class ValueKey {
+  final int value;
+  ValueKey(this.value);
+
+  int get hashCode => value.hashCode;
+  bool operator ==(Object other) => other is ValueKey && other.value == value;
+}
+
+// Identity hash codes are only kept on 64-bit architectures.
+final bool preservesHashes =
+    sizeOf<IntPtr>() == 8 &&
+    Platform.executableArguments.contains(
+      '--preserve-hashes-in-object-copy',
+    );
+
+late final StreamIterator si;
+late final SendPort sendPort;
+
+Future<T> sendReceive<T>(T graph) async {
+  sendPort.send(graph);
+  Expect.isTrue(await si.moveNext());
+  return si.current as T;
+}
+
+Future testLargeArray() async {
+  print('testLargeArray');
+  final shared = Key(-1);
+  final list = List<dynamic>.generate(3 * 1024 * 1024 + 17, (int i) {
+    switch (i % 5) {
+      case 0:
+        return i;
+      case 1:
+        return 'string $i';
+      case 2:
+        return Key(i);
+      case 3:
+        return shared;
+      default:
+        return i.toDouble();
+    }
+  });
+  final copy = await sendReceive(list);
+  Expect.equals(list.length, copy.length);
+  final sharedCopy = copy[3] as Key;
+  Expect.notIdentical(shared, sharedCopy);
+  for (int i = 0; i < list.length; i++) {
+    switch (i % 5) {
+      case 2:
+        Expect.equals(i, (copy[i] as Key).value);
+        break;
+      case 3:
+        Expect.identical(sharedCopy, copy[i]);
+        break;
+      default:
+        Expect.equals(list[i], copy[i]);
+    }
+  }
+}
+
+Future testLargeTypedData() async {
+  print('testLargeTypedData');
+  final bytes = Uint8List(7 * 1024 * 1024 + 3);
+  for (int i = 0; i < bytes.length; i++) {
+    bytes[i] = (i * 31) & 0xff;
+  }
+  final copy = await sendReceive([bytes]);
+  Expect.listEquals(bytes, copy[0] as Uint8List);
+}
+
+Future testIdentityKeys() async {
+  print('testIdentityKeys');
+  final map = <Key, int>{for (int i = 0; i < 100000; i++) Key(i): i};
+  final set = <Object>{...map.keys, 'a', 42};
+  map.remove(map.keys.first);
+  final copy = await sendReceive([map, set]);
+  final mapCopy = copy[0] as Map<Key, int>;
+  final setCopy = copy[1] as Set<Object>;
+  Expect.equals(map.length, mapCopy.length);
+  Expect.equals(set.length, setCopy.length);
+  final keys = map.keys.toList();
+  final keyCopies = mapCopy.keys.toList();
+  for (int i = 0; i < keys.length; i++) {
+    Expect.equals(keys[i].value, keyCopies[i].value);
+    Expect.equals(map[keys[i]], mapCopy[keyCopies[i]]);
+    Expect.isNull(mapCopy[keys[i]]);
+    if (preservesHashes) {
+      Expect.equals(identityHashCode(keys[i]), identityHashCode(keyCopies[i]));
+    }
+  }
+  for (final key in setCopy) {
+    Expect.isTrue(setCopy.contains(key));
+  }
+  Expect.isTrue(setCopy.contains('a'));
+  Expect.isTrue(setCopy.contains(42));
+}
+
+Future testValueKeys() async {
+  print('testValueKeys');
+  final map = <Object, int>{
+    for (int i = 0; i < 1000; i++) Key(i): i,
+    for (int i = 0; i < 1000; i++) ValueKey(i): i,
+  };
+  final copy = await sendReceive(map);
+  Expect.equals(map.length, copy.length);
+  for (int i = 0; i < 1000; i++) {
+    Expect.equals(i, copy[ValueKey(i)]);
+  }
+  for (final key in copy.keys) {
+    final value = key is Key ? key.value : (key as ValueKey).value;
+    Expect.equals(value, copy[key]);
+  }
+}
+
+main() async {
+  final receivePort = ReceivePort();
+  sendPort = receivePort.sendPort;
+  si = StreamIterator(receivePort);
+
+  await testLargeArray();
+  await testLargeTypedData();
+  await testIdentityKeys();
+  await testValueKeys();
+
+  si.cancel();
+  receivePort.close();
+}
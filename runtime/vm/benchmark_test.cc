@@ -20,6 +20,7 @@
 #include "vm/datastream.h"
 #include "vm/message_snapshot.h"
 #include "vm/stack_frame.h"
+#include "vm/thread_pool.h"
 #include "vm/timer.h"
 
 using dart::bin::File;
@@ -569,6 +570,56 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+// Each task schedules the next task of its chain, like a message handler
+// posting to another isolate, so that the pool runs many small tasks which
+// are mostly scheduled from its own workers.
+class PingPongTask : public ThreadPool::Task {
+ public:
+  PingPongTask(ThreadPool* pool,
+               intptr_t hops,
+               Monitor* monitor,
+               intptr_t* done)
+      : pool_(pool), hops_(hops), monitor_(monitor), done_(done) {}
+
+  virtual void Run() {
+    if (hops_ > 0) {
+      pool_->Run<PingPongTask>(pool_, hops_ - 1, monitor_, done_);
+      return;
+    }
+    MonitorLocker ml(monitor_);
+    (*done_)++;
+    ml.Notify();
+  }
+
+ private:
+  ThreadPool* pool_;
+  intptr_t hops_;
+  Monitor* monitor_;
+  intptr_t* done_;
+};
+
+BENCHMARK(ThreadPoolPingPong) {
+  const intptr_t kChainCount = 500;
+  const intptr_t kHopCount = 2000;
+  ThreadPool pool(OS::NumberOfAvailableProcessors());
+  Monitor monitor;
+  intptr_t done = 0;
+  Timer timer;
+  timer.Start();
+  for (intptr_t i = 0; i < kChainCount; i++) {
+    pool.Run<PingPongTask>(&pool, kHopCount, &monitor, &done);
+  }
+  {
+    MonitorLocker ml(&monitor);
+    while (done < kChainCount) {
+      ml.Wait();
+    }
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
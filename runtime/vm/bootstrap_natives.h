@@ -56,6 +56,7 @@ namespace dart {
   V(Capability_equals, 2)                                                      \
   V(Capability_get_hashcode, 1)                                                \
   V(RawReceivePort_factory, 2)                                                 \
+  V(RawReceivePort_factoryBounded, 4)                                          \
   V(RawReceivePort_get_id, 1)                                                  \
   V(RawReceivePort_closeInternal, 1)                                           \
   V(RawReceivePort_setActive, 2)                                               \
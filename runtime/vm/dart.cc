@@ -301,6 +301,15 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
     }
   }
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+  if (FLAG_dontneed_on_sweep && FLAG_transparent_huge_pages) {
+    // Free ranges found by the sweeper lie within a heap page, which is
+    // smaller than a huge page, so they could never be released.
+    return Utils::StrDup(
+        "--dontneed_on_sweep cannot be used with --transparent_huge_pages");
+  }
+#endif
+
   FrameLayout::Init();
 
   set_thread_start_callback(params->thread_start);
@@ -1491,6 +1491,15 @@ DART_EXPORT void* Dart_IsolateGroupData(Dart_Isolate isolate) {
   return reinterpret_cast<Isolate*>(isolate)->group()->embedder_data();
 }
 
+DART_EXPORT void Dart_SetIsolateSpawnPoolSize(intptr_t size) {
+  Isolate* isolate = Isolate::Current();
+  CHECK_ISOLATE(isolate);
+  if (size < 0) {
+    FATAL("%s expects argument 'size' to be non-negative.", CURRENT_FUNC);
+  }
+  isolate->group()->SetIsolatePoolSize(size);
+}
+
 DART_EXPORT Dart_Handle Dart_DebugName() {
   DARTSCOPE(Thread::Current());
   Isolate* I = T->isolate();
@@ -1865,6 +1874,58 @@ Dart_SetPerformanceMode(Dart_PerformanceMode mode) {
   return T->heap()->SetMode(mode);
 }
 
+DART_EXPORT Dart_Handle Dart_SetGCGoals(int64_t max_pause_micros,
+                                        intptr_t max_gc_time_percent) {
+  DARTSCOPE(Thread::Current());
+  if (max_pause_micros < 0) {
+    return Api::NewError(
+        "%s expects argument 'max_pause_micros' to be non-negative.",
+        CURRENT_FUNC);
+  }
+  if ((max_gc_time_percent < 0) || (max_gc_time_percent > 100)) {
+    return Api::NewError(
+        "%s expects argument 'max_gc_time_percent' to be between 0 and 100.",
+        CURRENT_FUNC);
+  }
+  T->heap()->SetGCGoals(max_pause_micros, max_gc_time_percent);
+  return Api::Success();
+}
+
+static void CopyGCHistogram(const GCHistogram& from, Dart_GCHistogram* to) {
+  to->count = from.count();
+  to->total_micros = from.total_micros();
+  to->max_micros = from.max_micros();
+  for (intptr_t i = 0; i < GCHistogram::kNumBuckets; i++) {
+    to->buckets[i] = from.bucket(i);
+  }
+}
+
+DART_EXPORT void Dart_GetGCStatistics(Dart_GCStatistics* statistics) {
+  COMPILE_ASSERT(GCHistogram::kNumBuckets == DART_GC_HISTOGRAM_BUCKETS);
+  COMPILE_ASSERT(GCStatistics::kNumReasons == Dart_GCReason_Count);
+  COMPILE_ASSERT(static_cast<intptr_t>(GCReason::kStoreBuffer) ==
+                 Dart_GCReason_StoreBuffer);
+  COMPILE_ASSERT(static_cast<intptr_t>(GCReason::kCatchUp) ==
+                 Dart_GCReason_CatchUp);
+  Thread* T = Thread::Current();
+  CHECK_ISOLATE(T->isolate());
+  if (statistics == nullptr) {
+    FATAL("%s expects argument 'statistics' to be non-null.", CURRENT_FUNC);
+  }
+  TransitionNativeToVM transition(T);
+  Heap* heap = T->heap();
+  const GCStatistics* stats = heap->gc_statistics();
+  for (intptr_t i = 0; i < GCStatistics::kNumReasons; i++) {
+    CopyGCHistogram(stats->pauses(static_cast<GCReason>(i)),
+                    &statistics->pauses[i]);
+  }
+  CopyGCHistogram(stats->concurrent_mark(), &statistics->concurrent_mark);
+  CopyGCHistogram(stats->concurrent_sweep(), &statistics->concurrent_sweep);
+  statistics->promoted_bytes = stats->promoted_bytes();
+  statistics->store_buffer_overflows = stats->store_buffer_overflows();
+  statistics->unswept_pages = heap->old_space()->UnsweptPageCount();
+}
+
 DART_EXPORT void Dart_ExitIsolate() {
   Thread* T = Thread::Current();
   CHECK_ISOLATE(T->isolate());
@@ -10327,6 +10327,115 @@ void main() {
   EXPECT_VALID(result);
 }
 
+static void SetGCGoalsTight(Dart_NativeArguments args) {
+  EXPECT_VALID(
+      Dart_SetGCGoals(/*max_pause_micros=*/1, /*max_gc_time_percent=*/50));
+}
+static void SetGCGoalsNone(Dart_NativeArguments args) {
+  EXPECT_VALID(Dart_SetGCGoals(0, 0));
+}
+
+static Dart_NativeFunction SetGCGoals_native_lookup(Dart_Handle name,
+                                                    int argument_count,
+                                                    bool* auto_setup_scope) {
+  const char* cstr = nullptr;
+  Dart_StringToCString(name, &cstr);
+  if (strcmp(cstr, "SetGCGoalsTight") == 0) {
+    return SetGCGoalsTight;
+  } else if (strcmp(cstr, "SetGCGoalsNone") == 0) {
+    return SetGCGoalsNone;
+  }
+  return nullptr;
+}
+
+TEST_CASE(DartAPI_SetGCGoals) {
+  // A goal that can never be met drives every controller to its limit.
+  const char* kScriptChars = R"(
+import "dart:typed_data";
+@pragma("vm:external-name", "SetGCGoalsTight")
+external void setGCGoalsTight();
+@pragma("vm:external-name", "SetGCGoalsNone")
+external void setGCGoalsNone();
+void main() {
+  setGCGoalsTight();
+  var live = [];
+  for (var i = 0; i < 100; i++) {
+    var t = [];
+    for (var j = 0; j < 1000; j++) {
+      t.add(Uint8List(100));
+    }
+    live.add(t);
+    if (live.length > 10) live.removeAt(0);
+  }
+  setGCGoalsNone();
+}
+)";
+  Dart_Handle lib =
+      TestCase::LoadTestScript(kScriptChars, &SetGCGoals_native_lookup);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, nullptr);
+  EXPECT_VALID(result);
+
+  EXPECT_ERROR(Dart_SetGCGoals(-1, 0),
+               "Dart_SetGCGoals expects argument 'max_pause_micros' to be "
+               "non-negative.");
+  EXPECT_ERROR(Dart_SetGCGoals(0, -1),
+               "Dart_SetGCGoals expects argument 'max_gc_time_percent' to be "
+               "between 0 and 100.");
+  EXPECT_ERROR(Dart_SetGCGoals(0, 101),
+               "Dart_SetGCGoals expects argument 'max_gc_time_percent' to be "
+               "between 0 and 100.");
+
+  // Every pause exceeds a 1 microsecond goal, so new-space shrinks to two
+  // TLABs per mutator and marking starts as early as it may.
+  EXPECT_VALID(Dart_SetGCGoals(/*max_pause_micros=*/1, 0));
+  {
+    TransitionNativeToVM transition(thread);
+    Heap* heap = thread->heap();
+    for (intptr_t i = 0; i < 20; i++) {
+      GCTestHelper::CollectNewSpace();
+    }
+    for (intptr_t i = 0; i < 10; i++) {
+      GCTestHelper::CollectOldSpace();
+    }
+    EXPECT_EQ(2 * thread->isolate_group()->MutatorCount() * kPageSizeInWords,
+              heap->new_space()->ThresholdInWords());
+    EXPECT_EQ(50, heap->old_space()->mark_start_percent());
+  }
+
+  // Without a goal, marking starts after all the allowed growth again.
+  EXPECT_VALID(Dart_SetGCGoals(0, 0));
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectOldSpace();
+    EXPECT_EQ(100, thread->heap()->old_space()->mark_start_percent());
+  }
+}
+
+TEST_CASE(DartAPI_GetGCStatistics) {
+  Dart_GCStatistics before;
+  Dart_GetGCStatistics(&before);
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+    GCTestHelper::CollectAllGarbage();
+    GCTestHelper::WaitForGCTasks();
+  }
+  Dart_GCStatistics after;
+  Dart_GetGCStatistics(&after);
+
+  // Both test collections are attributed to debugging.
+  const Dart_GCHistogram& pauses = after.pauses[Dart_GCReason_Debugging];
+  EXPECT_LE(before.pauses[Dart_GCReason_Debugging].count + 2, pauses.count);
+  int64_t bucketed = 0;
+  for (intptr_t i = 0; i < DART_GC_HISTOGRAM_BUCKETS; i++) {
+    bucketed += pauses.buckets[i];
+  }
+  EXPECT_EQ(pauses.count, bucketed);
+  EXPECT_LE(pauses.max_micros, pauses.total_micros);
+  EXPECT_LE(before.promoted_bytes, after.promoted_bytes);
+  EXPECT_EQ(0, after.unswept_pages);
+}
+
 static void NotifyLowMemoryNative(Dart_NativeArguments args) {
   Dart_NotifyLowMemory();
 }
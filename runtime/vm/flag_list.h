@@ -216,6 +216,9 @@ constexpr bool FLAG_support_il_printer = false;
   D(trace_optimized_ic_calls, bool, false,                                     \
     "Trace IC calls in optimized code.")                                       \
   D(trace_zones, bool, false, "Traces allocation sizes in the zone.")          \
+  P(transparent_huge_pages, bool, false,                                       \
+    "Back data heap pages with transparent huge pages (Linux only). Cannot "   \
+    "be combined with --dontneed_on_sweep.")                                   \
   P(truncating_left_shift, bool, true,                                         \
     "Optimize left shift to truncate if possible")                             \
   P(use_compactor, bool, false, "Compact the heap during old-space GC.")       \
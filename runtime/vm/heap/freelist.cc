@@ -91,7 +91,7 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
 
   // Postcondition: if allocation succeeds, the allocated block is writable.
   int index = IndexForSize(size);
-  if ((index != kNumLists) && free_map_.Test(index)) {
+  if ((index < kNumLists) && free_map_.Test(index)) {
     FreeListElement* element = DequeueElement(index);
     if (is_protected) {
       VirtualMemory::Protect(reinterpret_cast<void*>(element), size,
@@ -123,8 +123,46 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
     }
   }
 
+  // Search the large size class of the request for the best fit, then fall
+  // back to the first element of any larger class.
+  intptr_t large_index = LargeIndexForSize(size);
   FreeListElement* previous = nullptr;
-  FreeListElement* current = free_lists_[kNumLists];
+  FreeListElement* element = nullptr;
+  if (NextLargeIndex(large_index) == large_index) {
+    element = FindBestFitLocked(large_index, size, &previous);
+  }
+  if (element == nullptr) {
+    large_index = NextLargeIndex(large_index + 1);
+    if (large_index == -1) {
+      return 0;  // Trigger allocation of new page.
+    }
+    element = free_lists_[large_index];
+  }
+
+  intptr_t remainder_size = element->HeapSize() - size;
+  intptr_t region_size = size + FreeListElement::HeaderSizeFor(remainder_size);
+  if (is_protected) {
+    // Make the allocated block and the header of the remainder element
+    // writable.  The remainder will be non-writable if necessary after
+    // the call to SplitElementAfterAndEnqueue.
+    VirtualMemory::Protect(reinterpret_cast<void*>(element), region_size,
+                           VirtualMemory::kReadWrite);
+  }
+  UnlinkElementLocked(large_index, previous, element, is_protected,
+                      region_size);
+  SplitElementAfterAndEnqueue(element, size, is_protected);
+  return reinterpret_cast<uword>(element);
+}
+
+FreeListElement* FreeList::FindBestFitLocked(intptr_t index,
+                                             intptr_t size,
+                                             FreeListElement** previous) {
+  ASSERT(index >= kNumLists);
+  FreeListElement* best = nullptr;
+  intptr_t best_size = 0;
+  intptr_t lookahead = kBestFitLookahead;
+  FreeListElement* before = nullptr;
+  FreeListElement* current = free_lists_[index];
   // We are willing to search the freelist further for a big block.
   // For each successful free-list search we:
   //   * increase the search budget by #allocated-words
@@ -132,62 +170,64 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
   //     which guarantees us to not waste more than around 1 search step per
   //     word of allocation
   //
-  // If we run out of search budget we fall back to allocating a new page and
-  // reset the search budget.
+  // If we run out of search budget we fall back to a larger size class or a
+  // new page and reset the search budget.
   intptr_t tries_left = freelist_search_budget_ + (size >> kWordSizeLog2);
   while (current != nullptr) {
-    if (current->HeapSize() >= size) {
-      // Found an element large enough to hold the requested size. Dequeue,
-      // split and enqueue the remainder.
-      intptr_t remainder_size = current->HeapSize() - size;
-      intptr_t region_size =
-          size + FreeListElement::HeaderSizeFor(remainder_size);
-      if (is_protected) {
-        // Make the allocated block and the header of the remainder element
-        // writable.  The remainder will be non-writable if necessary after
-        // the call to SplitElementAfterAndEnqueue.
-        VirtualMemory::Protect(reinterpret_cast<void*>(current), region_size,
-                               VirtualMemory::kReadWrite);
-      }
-
-      if (previous == nullptr) {
-        free_lists_[kNumLists] = current->next();
-      } else {
-        // If the previous free list element's next field is protected, it
-        // needs to be unprotected before storing to it and reprotected
-        // after.
-        bool target_is_protected = false;
-        uword target_address = 0L;
-        if (is_protected) {
-          uword writable_start = reinterpret_cast<uword>(current);
-          uword writable_end = writable_start + region_size - 1;
-          target_address = previous->next_address();
-          target_is_protected =
-              !VirtualMemory::InSamePage(target_address, writable_start) &&
-              !VirtualMemory::InSamePage(target_address, writable_end);
-        }
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadWrite);
-        }
-        previous->set_next(current->next());
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadExecute);
-        }
-      }
-      SplitElementAfterAndEnqueue(current, size, is_protected);
-      freelist_search_budget_ =
-          Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return reinterpret_cast<uword>(current);
-    } else if (tries_left-- < 0) {
-      freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return 0;  // Trigger allocation of new page.
+    intptr_t current_size = current->HeapSize();
+    if ((current_size >= size) &&
+        ((best == nullptr) || (current_size < best_size))) {
+      best = current;
+      best_size = current_size;
+      *previous = before;
+      if (current_size == size) break;  // Exact fit.
     }
-    previous = current;
+    if ((best != nullptr) && (lookahead-- == 0)) break;
+    if (tries_left-- < 0) break;
+    before = current;
     current = current->next();
   }
-  return 0;
+  if (best != nullptr) {
+    freelist_search_budget_ =
+        Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
+  } else {
+    freelist_search_budget_ = kInitialFreeListSearchBudget;
+  }
+  return best;
+}
+
+void FreeList::UnlinkElementLocked(intptr_t index,
+                                   FreeListElement* previous,
+                                   FreeListElement* element,
+                                   bool is_protected,
+                                   intptr_t region_size) {
+  ASSERT(index >= kNumLists);
+  if (previous == nullptr) {
+    ASSERT(free_lists_[index] == element);
+    DequeueElement(index);
+    return;
+  }
+  // If the previous free list element's next field is protected, it needs to
+  // be unprotected before storing to it and reprotected after.
+  bool target_is_protected = false;
+  uword target_address = 0L;
+  if (is_protected) {
+    uword writable_start = reinterpret_cast<uword>(element);
+    uword writable_end = writable_start + region_size - 1;
+    target_address = previous->next_address();
+    target_is_protected =
+        !VirtualMemory::InSamePage(target_address, writable_start) &&
+        !VirtualMemory::InSamePage(target_address, writable_end);
+  }
+  if (target_is_protected) {
+    VirtualMemory::Protect(reinterpret_cast<void*>(target_address), kWordSize,
+                           VirtualMemory::kReadWrite);
+  }
+  previous->set_next(element->next());
+  if (target_is_protected) {
+    VirtualMemory::Protect(reinterpret_cast<void*>(target_address), kWordSize,
+                           VirtualMemory::kReadExecute);
+  }
 }
 
 void FreeList::Free(uword addr, intptr_t size) {
@@ -211,18 +251,23 @@ void FreeList::FreeLocked(uword addr, intptr_t size) {
 void FreeList::Reset() {
   MutexLocker ml(&mutex_);
   free_map_.Reset();
+  large_map_ = 0;
   last_free_small_size_ = -1;
-  for (int i = 0; i < (kNumLists + 1); i++) {
+  for (int i = 0; i < kNumAllLists; i++) {
     free_lists_[i] = nullptr;
   }
 }
 
 void FreeList::EnqueueElement(FreeListElement* element, intptr_t index) {
   FreeListElement* next = free_lists_[index];
-  if (next == nullptr && index != kNumLists) {
-    free_map_.Set(index, true);
-    last_free_small_size_ =
-        Utils::Maximum(last_free_small_size_, index << kObjectAlignmentLog2);
+  if (next == nullptr) {
+    if (index < kNumLists) {
+      free_map_.Set(index, true);
+      last_free_small_size_ =
+          Utils::Maximum(last_free_small_size_, index << kObjectAlignmentLog2);
+    } else {
+      large_map_ |= 1u << (index - kNumLists);
+    }
   }
   element->set_next(next);
   free_lists_[index] = element;
@@ -283,31 +328,21 @@ FreeListElement* FreeList::TryAllocateLarge(intptr_t minimum_size) {
 
 FreeListElement* FreeList::TryAllocateLargeLocked(intptr_t minimum_size) {
   DEBUG_ASSERT(mutex_.IsOwnedByCurrentThread());
+  intptr_t index = LastLargeIndex();
+  intptr_t minimum_index = LargeIndexForSize(minimum_size);
+  if (index < minimum_index) {
+    return nullptr;  // Trigger allocation of new page.
+  }
+  if (index > minimum_index) {
+    return DequeueElement(index);
+  }
   FreeListElement* previous = nullptr;
-  FreeListElement* current = free_lists_[kNumLists];
-  // TODO(koda): Find largest.
-  // We are willing to search the freelist further for a big block.
-  intptr_t tries_left =
-      freelist_search_budget_ + (minimum_size >> kWordSizeLog2);
-  while (current != nullptr) {
-    FreeListElement* next = current->next();
-    if (current->HeapSize() >= minimum_size) {
-      if (previous == nullptr) {
-        free_lists_[kNumLists] = next;
-      } else {
-        previous->set_next(next);
-      }
-      freelist_search_budget_ =
-          Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return current;
-    } else if (tries_left-- < 0) {
-      freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return nullptr;  // Trigger allocation of new page.
-    }
-    previous = current;
-    current = next;
+  FreeListElement* element = FindBestFitLocked(index, minimum_size, &previous);
+  if (element != nullptr) {
+    UnlinkElementLocked(index, previous, element, /*is_protected=*/false,
+                        /*region_size=*/0);
   }
-  return nullptr;
+  return element;
 }
 
 }  // namespace dart
@@ -91,6 +91,9 @@ class FreeList {
   void FreeLocked(uword addr, intptr_t size);
 
   // Returns a large element, at least 'minimum_size', or NULL if none exists.
+  // Takes any element of the highest non-empty size class, so that bump
+  // regions carved from it last long. If that is the class 'minimum_size'
+  // falls in, whose elements may be too small, takes the best fit within it.
   FreeListElement* TryAllocateLarge(intptr_t minimum_size);
   FreeListElement* TryAllocateLargeLocked(intptr_t minimum_size);
 
@@ -102,7 +105,7 @@ class FreeList {
       return 0;
     }
     int index = IndexForSize(size);
-    if (index != kNumLists && free_map_.Test(index)) {
+    if (index < kNumLists && free_map_.Test(index)) {
       return reinterpret_cast<uword>(DequeueElement(index));
     }
     if ((index + 1) < kNumLists) {
@@ -161,8 +164,19 @@ class FreeList {
   void AddUnaccountedSize(intptr_t size) { unaccounted_size_ += size; }
 
  private:
-  static constexpr int kNumLists = 128;
+  // Small elements are kept in exact-size lists, one per allocation unit.
+  static constexpr int kNumListsLog2 = 7;
+  static constexpr int kNumLists = 1 << kNumListsLog2;
+  // Larger elements are binned by power-of-two size class, starting at
+  // kNumLists allocation units. Any element in a larger class than a request
+  // fits it, so only the request's own class ever needs to be searched.
+  static constexpr int kNumLargeLists = 16;
+  static constexpr int kNumAllLists = kNumLists + kNumLargeLists;
+  static_assert(kNumLargeLists <= 32, "large_map_ is 32 bits");
   static constexpr intptr_t kInitialFreeListSearchBudget = 1000;
+  // How many more elements of a size class to look at for a better fit once
+  // one that fits is found.
+  static constexpr intptr_t kBestFitLookahead = 8;
 
   static intptr_t IndexForSize(intptr_t size) {
     ASSERT(size >= kObjectAlignment);
@@ -170,25 +184,73 @@ class FreeList {
 
     intptr_t index = size >> kObjectAlignmentLog2;
     if (index >= kNumLists) {
-      index = kNumLists;
+      index = LargeIndexForSize(size);
     }
     return index;
   }
 
+  // The first large list whose elements may fit 'size'.
+  static intptr_t LargeIndexForSize(intptr_t size) {
+    intptr_t units = size >> (kObjectAlignmentLog2 + kNumListsLog2);
+    if (units == 0) {
+      return kNumLists;
+    }
+    intptr_t size_class = Utils::HighestBit(units);
+    return kNumLists + Utils::Minimum<intptr_t>(size_class, kNumLargeLists - 1);
+  }
+
+  // Returns the first non-empty large list at or after 'index', or -1.
+  intptr_t NextLargeIndex(intptr_t index) const {
+    ASSERT(index >= kNumLists);
+    intptr_t bit = index - kNumLists;
+    if (bit >= kNumLargeLists) {
+      return -1;
+    }
+    uint32_t map = large_map_ >> bit;
+    if (map == 0) {
+      return -1;
+    }
+    return index + Utils::CountTrailingZeros32(map);
+  }
+
+  // Returns the last non-empty large list, or -1.
+  intptr_t LastLargeIndex() const {
+    if (large_map_ == 0) {
+      return -1;
+    }
+    return kNumLists + Utils::HighestBit(large_map_);
+  }
+
+  // Searches a large list for the smallest element that fits 'size', within
+  // the search budget. Sets 'previous' to the element before it.
+  FreeListElement* FindBestFitLocked(intptr_t index,
+                                     intptr_t size,
+                                     FreeListElement** previous);
+  void UnlinkElementLocked(intptr_t index,
+                           FreeListElement* previous,
+                           FreeListElement* element,
+                           bool is_protected,
+                           intptr_t region_size);
+
   intptr_t LengthLocked(int index) const;
 
   void EnqueueElement(FreeListElement* element, intptr_t index);
   FreeListElement* DequeueElement(intptr_t index) {
     FreeListElement* result = free_lists_[index];
     FreeListElement* next = result->next();
-    if (next == nullptr && index != kNumLists) {
-      intptr_t size = index << kObjectAlignmentLog2;
-      if (size == last_free_small_size_) {
-        // Note: This is -1 * kObjectAlignment if no other small sizes remain.
-        last_free_small_size_ =
-            free_map_.ClearLastAndFindPrevious(index) * kObjectAlignment;
+    if (next == nullptr) {
+      if (index < kNumLists) {
+        intptr_t size = index << kObjectAlignmentLog2;
+        if (size == last_free_small_size_) {
+          // Note: This is -1 * kObjectAlignment if no other small sizes
+          // remain.
+          last_free_small_size_ =
+              free_map_.ClearLastAndFindPrevious(index) * kObjectAlignment;
+        } else {
+          free_map_.Set(index, false);
+        }
       } else {
-        free_map_.Set(index, false);
+        large_map_ &= ~(1u << (index - kNumLists));
       }
     }
     free_lists_[index] = next;
@@ -212,7 +274,10 @@ class FreeList {
 
   BitSet<kNumLists> free_map_;
 
-  FreeListElement* free_lists_[kNumLists + 1];
+  // Bit i is set when free_lists_[kNumLists + i] is non-empty.
+  uint32_t large_map_;
+
+  FreeListElement* free_lists_[kNumAllLists];
 
   intptr_t freelist_search_budget_ = kInitialFreeListSearchBudget;
 
@@ -228,6 +228,37 @@ static void TestRegress38528(intptr_t header_overlap) {
   reinterpret_cast<void (*)()>(other_code)();
 }
 
+TEST_CASE(FreeListLargeSizeClasses) {
+  std::unique_ptr<FreeList> free_list(new FreeList());
+  const intptr_t kBlobSize = 1 * MB;
+  std::unique_ptr<VirtualMemory> region(VirtualMemory::Allocate(
+      kBlobSize, /* is_executable */ false, /* is_compressed */ false,
+      "test"));
+  const uword blob = region->start();
+
+  // Two blocks in the same size class and one much larger block.
+  const uword loose = blob;
+  const uword tight = blob + 16 * KB;
+  const uword huge = blob + 32 * KB;
+  free_list->Free(tight, 5 * KB / 2);
+  free_list->Free(huge, 64 * KB);
+  free_list->Free(loose, 3 * KB);
+
+  // Allocation takes the best fit, not the most recently freed block.
+  EXPECT_EQ(tight, free_list->TryAllocate(5 * KB / 2, false));
+  // A request larger than its whole size class comes from a larger class.
+  EXPECT_EQ(huge, free_list->TryAllocate(4 * KB, false));
+  // Bump regions are carved from the largest remaining block.
+  {
+    MutexLocker ml(free_list->mutex());
+    EXPECT_EQ(huge + 4 * KB, reinterpret_cast<uword>(
+                                 free_list->TryAllocateLargeLocked(16)));
+    EXPECT_EQ(loose, reinterpret_cast<uword>(
+                         free_list->TryAllocateLargeLocked(16)));
+    EXPECT(free_list->TryAllocateLargeLocked(16) == nullptr);
+  }
+}
+
 TEST_CASE(Regress38528) {
   for (const intptr_t i : {-2, -1, 0, 1, 2}) {
     TestRegress38528(i);
@@ -0,0 +1,65 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/gc_statistics.h"
+
+#include "platform/utils.h"
+#include "vm/heap/heap.h"
+#include "vm/json_stream.h"
+
+namespace dart {
+
+intptr_t GCHistogram::BucketFor(int64_t micros) {
+  if (micros <= 0) {
+    return 0;
+  }
+  const intptr_t bucket = Utils::HighestBit(micros) + 1;
+  return Utils::Minimum(bucket, kNumBuckets - 1);
+}
+
+void GCHistogram::Record(int64_t micros) {
+  micros = Utils::Maximum<int64_t>(micros, 0);
+  count_++;
+  total_micros_ += micros;
+  buckets_[BucketFor(micros)]++;
+  int64_t max = max_micros_;
+  while ((micros > max) && !max_micros_.compare_exchange_weak(max, micros)) {
+  }
+}
+
+#ifndef PRODUCT
+void GCHistogram::PrintJSON(JSONObject* jsobj) const {
+  jsobj->AddProperty64("count", count());
+  jsobj->AddProperty64("totalMicros", total_micros());
+  jsobj->AddProperty64("maxMicros", max_micros());
+  JSONArray buckets(jsobj, "buckets");
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    buckets.AddValue64(bucket(i));
+  }
+}
+
+void GCStatistics::PrintJSON(JSONObject* jsobj) const {
+  {
+    JSONArray pauses(jsobj, "pauses");
+    for (intptr_t i = 0; i < kNumReasons; i++) {
+      const GCReason reason = static_cast<GCReason>(i);
+      JSONObject histogram(&pauses);
+      histogram.AddProperty("reason", Heap::GCReasonToString(reason));
+      pauses_[i].PrintJSON(&histogram);
+    }
+  }
+  {
+    JSONObject histogram(jsobj, "concurrentMark");
+    concurrent_mark_.PrintJSON(&histogram);
+  }
+  {
+    JSONObject histogram(jsobj, "concurrentSweep");
+    concurrent_sweep_.PrintJSON(&histogram);
+  }
+  jsobj->AddProperty64("promotedBytes", promoted_bytes());
+  jsobj->AddProperty64("storeBufferOverflows", store_buffer_overflows());
+}
+#endif  // !PRODUCT
+
+}  // namespace dart
@@ -0,0 +1,108 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_GC_STATISTICS_H_
+#define RUNTIME_VM_HEAP_GC_STATISTICS_H_
+
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/heap/spaces.h"
+
+namespace dart {
+
+class JSONObject;
+
+// A histogram of durations with power-of-two microsecond buckets. Bucket 0
+// counts samples under 1us, bucket i counts samples in [2^(i-1), 2^i) us, and
+// the last bucket also counts everything longer. Recording is a handful of
+// relaxed atomic adds, so it is cheap enough to leave on, and readers may
+// sample it at any time without synchronizing with the GC.
+class GCHistogram {
+ public:
+  static constexpr intptr_t kNumBuckets = 24;
+
+  GCHistogram() {}
+
+  void Record(int64_t micros);
+
+  int64_t count() const { return count_; }
+  int64_t total_micros() const { return total_micros_; }
+  int64_t max_micros() const { return max_micros_; }
+  int64_t bucket(intptr_t i) const {
+    ASSERT((i >= 0) && (i < kNumBuckets));
+    return buckets_[i];
+  }
+
+#ifndef PRODUCT
+  void PrintJSON(JSONObject* jsobj) const;
+#endif  // !PRODUCT
+
+ private:
+  static intptr_t BucketFor(int64_t micros);
+
+  RelaxedAtomic<int64_t> count_ = {0};
+  RelaxedAtomic<int64_t> total_micros_ = {0};
+  RelaxedAtomic<int64_t> max_micros_ = {0};
+  RelaxedAtomic<int64_t> buckets_[kNumBuckets] = {};
+
+  DISALLOW_COPY_AND_ASSIGN(GCHistogram);
+};
+
+// Always-on GC telemetry for one heap, exported by the _getGCStatistics
+// service RPC and Dart_GetGCStatistics.
+class GCStatistics {
+ public:
+  static constexpr intptr_t kNumReasons =
+      static_cast<intptr_t>(GCReason::kCatchUp) + 1;
+
+  GCStatistics() {}
+
+  void RecordPause(GCReason reason, int64_t micros) {
+    pauses_[static_cast<intptr_t>(reason)].Record(micros);
+  }
+  void RecordPromotion(intptr_t bytes) { promoted_bytes_ += bytes; }
+  void RecordStoreBufferOverflow() { store_buffer_overflows_++; }
+  void RecordConcurrentSweep(int64_t micros) {
+    concurrent_sweep_.Record(micros);
+  }
+
+  // Concurrent marking is measured from the end of the pause that starts it
+  // to the start of the pause that finalizes it.
+  void ConcurrentMarkStarted(int64_t micros) {
+    concurrent_mark_start_micros_ = micros;
+  }
+  void ConcurrentMarkFinished(int64_t micros) {
+    int64_t start = concurrent_mark_start_micros_.exchange(0);
+    if (start != 0) {
+      concurrent_mark_.Record(micros - start);
+    }
+  }
+
+  const GCHistogram& pauses(GCReason reason) const {
+    return pauses_[static_cast<intptr_t>(reason)];
+  }
+  const GCHistogram& concurrent_mark() const { return concurrent_mark_; }
+  const GCHistogram& concurrent_sweep() const { return concurrent_sweep_; }
+  int64_t promoted_bytes() const { return promoted_bytes_; }
+  int64_t store_buffer_overflows() const { return store_buffer_overflows_; }
+
+#ifndef PRODUCT
+  void PrintJSON(JSONObject* jsobj) const;
+#endif  // !PRODUCT
+
+ private:
+  GCHistogram pauses_[kNumReasons];
+  GCHistogram concurrent_mark_;
+  GCHistogram concurrent_sweep_;
+  RelaxedAtomic<int64_t> promoted_bytes_ = {0};
+  RelaxedAtomic<int64_t> store_buffer_overflows_ = {0};
+  RelaxedAtomic<int64_t> concurrent_mark_start_micros_ = {0};
+
+  DISALLOW_COPY_AND_ASSIGN(GCStatistics);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_GC_STATISTICS_H_
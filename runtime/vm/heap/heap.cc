@@ -131,6 +131,16 @@ uword Heap::AllocateOld(Thread* thread, intptr_t size, bool is_exec) {
     if (addr != 0) {
       return addr;
     }
+    // Sweep pages on demand rather than waiting for the concurrent sweeper to
+    // finish all of them. Executable pages are never swept concurrently, and
+    // sizes too large for the free lists can only be allocated on a new page.
+    while (!is_exec && IsAllocatableViaFreeLists(size) &&
+           old_space_.SweepNextPage()) {
+      addr = old_space_.TryAllocate(size, is_exec);
+      if (addr != 0) {
+        return addr;
+      }
+    }
     // Wait for any GC tasks that are in progress.
     WaitForSweeperTasks(thread);
     addr = old_space_.TryAllocate(size, is_exec);
@@ -458,6 +468,14 @@ Dart_PerformanceMode Heap::SetMode(Dart_PerformanceMode new_mode) {
   return old_mode;
 }
 
+void Heap::SetGCGoals(int64_t max_pause_micros,
+                      intptr_t max_gc_time_percent) {
+  ASSERT(max_pause_micros >= 0);
+  ASSERT((max_gc_time_percent >= 0) && (max_gc_time_percent <= 100));
+  max_pause_micros_ = max_pause_micros;
+  old_space_.SetGCTimeGoal(max_gc_time_percent);
+}
+
 void Heap::CollectNewSpaceGarbage(Thread* thread,
                                   GCType type,
                                   GCReason reason) {
@@ -477,6 +495,7 @@ void Heap::CollectNewSpaceGarbage(Thread* thread,
     {
       NOT_IN_PRODUCT(VMTagScope tagScope(thread, VMTag::kGCNewSpaceTagId));
       if (reason == GCReason::kStoreBuffer) {
+        gc_statistics_.RecordStoreBufferOverflow();
         // The remembered set may become too full, increasing the time of
         // stop-the-world phases, if new-space or to-be-evacuated objects are
         // pointed to by too many objects. This is resolved by evacuating
@@ -540,6 +559,7 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
         /*at_safepoint=*/true);
 
     RecordBeforeGC(type, reason);
+    gc_statistics_.ConcurrentMarkFinished(stats_.before_.micros_);
     NOT_IN_PRODUCT(VMTagScope tagScope(thread, VMTag::kGCOldSpaceTagId));
     TIMELINE_FUNCTION_GC_DURATION(thread, "CollectOldGeneration");
     old_space_.CollectGarbage(thread, /*compact=*/type == GCType::kMarkCompact,
@@ -647,6 +667,9 @@ void Heap::StartConcurrentMarking(Thread* thread, GCReason reason) {
   TIMELINE_FUNCTION_GC_DURATION(thread, "StartConcurrentMarking");
   old_space_.CollectGarbage(thread, /*compact=*/false, /*finalize=*/false);
   RecordAfterGC(GCType::kStartConcurrentMark);
+  if (old_space_.phase() != PageSpace::kDone) {
+    gc_statistics_.ConcurrentMarkStarted(stats_.after_.micros_);
+  }
   PrintStats();
 #if defined(SUPPORT_TIMELINE)
   PrintStatsToTimeline(&tbes, reason);
@@ -999,6 +1022,14 @@ void Heap::PrintMemoryUsageJSON(JSONObject* jsobj) const {
   jsobj->AddProperty64("heapUsage", TotalUsedInWords() * kWordSize);
   jsobj->AddProperty64("heapCapacity", TotalCapacityInWords() * kWordSize);
   jsobj->AddProperty64("externalUsage", TotalExternalInWords() * kWordSize);
+  old_space_.PrintSweepStateToJSONObject(jsobj);
+}
+
+void Heap::PrintGCStatisticsJSON(JSONStream* stream) const {
+  JSONObject jsobj(stream);
+  jsobj.AddProperty("type", "_GCStatistics");
+  gc_statistics_.PrintJSON(&jsobj);
+  jsobj.AddProperty("unsweptPages", old_space_.UnsweptPageCount());
 }
 #endif  // PRODUCT
 
@@ -1029,6 +1060,7 @@ void Heap::RecordBeforeGC(GCType type, GCReason reason) {
 void Heap::RecordAfterGC(GCType type) {
   stats_.after_.micros_ = OS::GetCurrentMonotonicMicros();
   int64_t delta = stats_.after_.micros_ - stats_.before_.micros_;
+  gc_statistics_.RecordPause(stats_.reason_, delta);
   if (stats_.type_ == GCType::kScavenge) {
     new_space_.AddGCTime(delta);
     new_space_.IncrementCollections();
@@ -15,6 +15,7 @@
 #include "vm/allocation.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/gc_statistics.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/scavenger.h"
 #include "vm/heap/spaces.h"
@@ -103,6 +104,10 @@ class Heap {
   Dart_PerformanceMode mode() const { return mode_; }
   Dart_PerformanceMode SetMode(Dart_PerformanceMode mode);
 
+  // See Dart_SetGCGoals. Zero means no goal.
+  void SetGCGoals(int64_t max_pause_micros, intptr_t max_gc_time_percent);
+  int64_t max_pause_micros() const { return max_pause_micros_; }
+
   // Collect a single generation.
   void CollectGarbage(Thread* thread, GCType type, GCReason reason);
 
@@ -261,6 +266,9 @@ class Heap {
   void PrintMemoryUsageJSON(JSONStream* stream) const;
   void PrintMemoryUsageJSON(JSONObject* jsobj) const;
 
+  // Prints the always-on GC telemetry; see GCStatistics.
+  void PrintGCStatisticsJSON(JSONStream* stream) const;
+
   // The heap map contains the sizes and class ids for the objects in each page.
   void PrintHeapMapToJSONStream(IsolateGroup* isolate_group,
                                 JSONStream* stream) {
@@ -270,6 +278,8 @@ class Heap {
 
   intptr_t ReachabilityBarrier() { return old_space_.collections(); }
 
+  GCStatistics* gc_statistics() { return &gc_statistics_; }
+
   IsolateGroup* isolate_group() const { return isolate_group_; }
   bool is_vm_isolate() const { return is_vm_isolate_; }
 
@@ -358,8 +368,10 @@ class Heap {
 
   // GC stats collection.
   GCStats stats_;
+  GCStatistics gc_statistics_;
 
   RelaxedAtomic<Dart_PerformanceMode> mode_ = {Dart_PerformanceMode_Default};
+  RelaxedAtomic<int64_t> max_pause_micros_ = {0};
 
   // This heap is in read-only mode: No allocation is allowed.
   bool read_only_;
@@ -483,6 +495,7 @@ class GCTestHelper : public AllStatic {
     ASSERT(thread->execution_state() == Thread::kThreadInVM);
     thread->heap()->WaitForMarkerTasks(thread);
     thread->heap()->WaitForSweeperTasks(thread);
+    thread->heap()->new_space()->WaitForReleaseTasks();
   }
 };
 #endif  // TESTING
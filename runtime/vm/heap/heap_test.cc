@@ -16,6 +16,7 @@
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/incremental_compactor.h"
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
 #include "vm/object_graph.h"
@@ -26,6 +27,8 @@
 namespace dart {
 
 DECLARE_FLAG(int, early_tenuring_threshold);
+DECLARE_FLAG(bool, pretenure);
+DECLARE_FLAG(int, evacuation_pause_budget_micros);
 
 TEST_CASE(OldGC) {
   const char* kScriptChars =
@@ -1199,7 +1202,162 @@ ISOLATE_UNIT_TEST_CASE(FinalizerEntry_Generations) {
   FinalizerEntry_Generations(kOld, kImm, false, false, false);
 }
 
+ISOLATE_UNIT_TEST_CASE(Pretenuring) {
+  SetFlagScope<bool> sfs(&FLAG_pretenure, true);
+  SetFlagScope<int> sfs2(&FLAG_early_tenuring_threshold, 100);  // I.e., off.
+  Scavenger* new_space = thread->heap()->new_space();
+
+  GCTestHelper::CollectAllGarbage();
+  EXPECT(!new_space->ShouldPretenure(kDoubleCid));
+
+  // Every Double allocated before this scavenge survives it.
+  const intptr_t kLength = 10000;
+  const Array& survivors = Array::Handle(Array::New(kLength, Heap::kOld));
+  Double& value = Double::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    value = Double::New(static_cast<double>(i), Heap::kNew);
+    survivors.SetAt(i, value);
+  }
+  GCTestHelper::CollectNewSpace();
+  EXPECT(new_space->ShouldPretenure(kDoubleCid));
+
+  // Instances of a pretenured class are promoted by their first scavenge.
+  value = Double::New(1.0, Heap::kNew);
+  EXPECT(value.IsNew());
+  GCTestHelper::CollectNewSpace();
+  EXPECT(value.IsOld());
+
+  // Once most instances die young again, the class is no longer pretenured.
+  for (intptr_t i = 0; i < 4 * kLength; i++) {
+    value = Double::New(static_cast<double>(i), Heap::kNew);
+  }
+  GCTestHelper::CollectNewSpace();
+  EXPECT(!new_space->ShouldPretenure(kDoubleCid));
+}
+
+ISOLATE_UNIT_TEST_CASE(IncrementalCompactorPauseBudget) {
+  SetFlagScope<bool> sfs(&FLAG_use_incremental_compactor, true);
+  SetFlagScope<int> sfs2(&FLAG_evacuation_pause_budget_micros, 1);
+  Heap* heap = thread->heap();
+  PageSpace* old_space = heap->old_space();
+  const intptr_t old_speed = old_space->evacuate_words_per_micro();
+  const intptr_t size_bound =
+      (heap->new_space()->ThresholdInWords() * kWordSize) / 4;
+
+  // A fast evacuation raises the bound above the new-space based one.
+  old_space->set_evacuate_words_per_micro(size_bound);
+  EXPECT_EQ(size_bound * kWordSize,
+            GCIncrementalCompactor::MaxEvacuatedBytes(old_space));
+
+  // A slow one still allows a sparse page to be evacuated, so that the speed
+  // keeps being measured.
+  old_space->set_evacuate_words_per_micro(1);
+  EXPECT_EQ(kPageSize / 2,
+            GCIncrementalCompactor::MaxEvacuatedBytes(old_space));
+
+  GCTestHelper::CollectAllGarbage(/*compact=*/true);
+
+  // Leave one in every sixteen objects alive, so their pages become sparse.
+  const intptr_t kLength = 20000;
+  const intptr_t kNumSurvivors = kLength / 16;
+  const Array& survivors = Array::Handle(Array::New(kNumSurvivors, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element = Array::New(8, Heap::kOld);
+    if ((i % 16) == 0) {
+      survivors.SetAt(i / 16, element);
+    }
+  }
+  GCTestHelper::CollectOldSpace();
+
+  uword* addresses = new uword[kNumSurvivors];
+  for (intptr_t i = 0; i < kNumSurvivors; i++) {
+    addresses[i] = UntaggedObject::ToAddr(survivors.At(i));
+  }
+  old_space->set_evacuate_words_per_micro(1);
+  GCTestHelper::CollectOldSpace();
+  intptr_t moved = 0;
+  for (intptr_t i = 0; i < kNumSurvivors; i++) {
+    if (UntaggedObject::ToAddr(survivors.At(i)) != addresses[i]) {
+      moved++;
+    }
+  }
+  delete[] addresses;
+  EXPECT(moved > 0);
+  EXPECT(old_space->evacuate_words_per_micro() > 0);
+
+  old_space->set_evacuate_words_per_micro(old_speed);
+}
+
 #if !defined(PRODUCT) && defined(DART_HOST_OS_LINUX)
+ISOLATE_UNIT_TEST_CASE(ConcurrentScavengeRelease) {
+  Heap* heap = thread->heap();
+  Dart_PerformanceMode old_mode = heap->SetMode(Dart_PerformanceMode_Latency);
+
+  // From-spaces are released by helper threads while new objects are being
+  // allocated into pages that may be recycled through the page cache.
+  const Array& survivors = Array::Handle(Array::New(100, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < 10; i++) {
+    for (intptr_t j = 0; j < 10000; j++) {
+      element = Array::New(8, Heap::kNew);
+      survivors.SetAt(j % survivors.Length(), element);
+    }
+    GCTestHelper::CollectNewSpace();
+  }
+  GCTestHelper::WaitForGCTasks();
+  for (intptr_t i = 0; i < survivors.Length(); i++) {
+    element ^= survivors.At(i);
+    EXPECT_EQ(8, element.Length());
+  }
+
+  heap->SetMode(old_mode);
+}
+
+ISOLATE_UNIT_TEST_CASE(MarkLargeArrayInChunks) {
+  // Large arrays are split into chunks shared between the marking tasks. Every
+  // chunk must be visited, in each of several marking cycles.
+  const intptr_t kLength = 1 * MB;
+  const Array& array = Array::Handle(Array::New(kLength, Heap::kOld));
+  Double& element = Double::Handle();
+  for (intptr_t i = 0; i < kLength; i += 7) {
+    element = Double::New(static_cast<double>(i), Heap::kOld);
+    array.SetAt(i, element);
+  }
+  for (intptr_t gc = 0; gc < 2; gc++) {
+    GCTestHelper::CollectAllGarbage();
+    GCTestHelper::WaitForGCTasks();
+    for (intptr_t i = 0; i < kLength; i += 7) {
+      element ^= array.At(i);
+      EXPECT_EQ(static_cast<double>(i), element.value());
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(LazySweep) {
+  // Leave many partially live pages for the concurrent sweeper, and sweep
+  // some of them from the mutator while it runs.
+  const intptr_t kLength = 100000;
+  const Array& survivors = Array::Handle(Array::New(kLength / 2, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element = Array::New(4, Heap::kOld);
+    if ((i % 2) == 0) {
+      survivors.SetAt(i / 2, element);
+    }
+  }
+  GCTestHelper::CollectOldSpace();
+  PageSpace* old_space = thread->heap()->old_space();
+  while (old_space->SweepNextPage()) {
+  }
+  GCTestHelper::WaitForGCTasks();
+  EXPECT_EQ(PageSpace::kDone, old_space->phase());
+  for (intptr_t i = 0; i < survivors.Length(); i++) {
+    element ^= survivors.At(i);
+    EXPECT_EQ(4, element.Length());
+  }
+}
+
 ISOLATE_UNIT_TEST_CASE(SweepDontNeed) {
   auto gc_with_fragmentation = [&] {
     HANDLESCOPE(thread);
@@ -6,6 +6,7 @@
 
 #include "platform/assert.h"
 #include "vm/dart_api_state.h"
+#include "vm/flags.h"
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/freelist.h"
@@ -18,6 +19,14 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            evacuation_pause_budget_micros,
+            0,
+            "When positive, size the incremental compactor's evacuation set "
+            "so the stop-the-world evacuation takes about this long at the "
+            "measured evacuation speed, instead of bounding it by new-space "
+            "size. A pause goal set with Dart_SetGCGoals takes precedence.");
+
 void GCIncrementalCompactor::Prologue(PageSpace* old_space) {
   ASSERT(Thread::Current()->OwnsGCSafepoint());
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "StartIncrementalCompact");
@@ -147,8 +156,8 @@ class PrologueTask : public SafepointTask {
     for (;;) {
       intptr_t chunk = state_->freelist_cursor.fetch_add(1);
       if (chunk >= state_->freelist_limit) break;
-      intptr_t list_index = chunk / (FreeList::kNumLists + 1);
-      intptr_t size_class_index = chunk % (FreeList::kNumLists + 1);
+      intptr_t list_index = chunk / FreeList::kNumAllLists;
+      intptr_t size_class_index = chunk % FreeList::kNumAllLists;
       FreeList* freelist = &old_space_->freelists_[list_index];
 
       // Empty bump-region, no need to prune this.
@@ -174,15 +183,39 @@ class PrologueTask : public SafepointTask {
   DISALLOW_COPY_AND_ASSIGN(PrologueTask);
 };
 
-bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
-  // Only evacuate pages that are at least half empty.
-  constexpr intptr_t kEvacuationThreshold = kPageSize / 2;
+// Only evacuate pages that are at least half empty.
+static constexpr intptr_t kEvacuationThreshold = kPageSize / 2;
 
-  // Evacuate no more than this amount of objects. This puts a bound on the
+intptr_t GCIncrementalCompactor::MaxEvacuatedBytes(PageSpace* old_space) {
+  // Without a pause budget, or until evacuation has been timed, evacuate no
+  // more than this amount of objects. This puts a bound on the
   // stop-the-world evacuate step that is similar to the existing longest
   // stop-the-world step of the scavenger.
-  const intptr_t kMaxEvacuatedBytes =
+  const intptr_t max_evacuated_bytes =
       (old_space->heap_->new_space()->ThresholdInWords() << kWordSizeLog2) / 4;
+  int64_t budget_micros = old_space->heap_->max_pause_micros();
+  if (budget_micros == 0) {
+    budget_micros = FLAG_evacuation_pause_budget_micros;
+  }
+  if ((budget_micros <= 0) || (old_space->evacuate_words_per_micro_ == 0)) {
+    return max_evacuated_bytes;
+  }
+
+  // Once we know how fast evacuation is, bound it by time instead, so that
+  // heaps that evacuate quickly can reclaim more than the size-based bound.
+  // The sparsest pages are taken first, so this frees the most pages that
+  // fit in the budget. Always allow at least one candidate page, so that a
+  // slow measurement cannot stop evacuation, and with it further
+  // measurements, for good.
+  const int64_t budget_bytes =
+      (budget_micros * old_space->evacuate_words_per_micro_) << kWordSizeLog2;
+  return static_cast<intptr_t>(Utils::Minimum<int64_t>(
+      Utils::Maximum<int64_t>(kEvacuationThreshold, budget_bytes),
+      kIntptrMax));
+}
+
+bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
+  const intptr_t max_evacuated_bytes = MaxEvacuatedBytes(old_space);
 
   PrologueState state;
   {
@@ -206,7 +239,7 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     intptr_t cumulative_live_bytes = 0;
     for (intptr_t i = 0; i < state.pages.length(); i++) {
       intptr_t live_bytes = state.pages[i].live_bytes;
-      if (cumulative_live_bytes + live_bytes <= kMaxEvacuatedBytes) {
+      if (cumulative_live_bytes + live_bytes <= max_evacuated_bytes) {
         num_candidates++;
         cumulative_live_bytes += live_bytes;
         state.pages[i].page->set_evacuation_candidate(true);
@@ -222,10 +255,8 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
 
     state.page_cursor = 0;
     state.page_limit = num_candidates;
-    state.freelist_cursor =
-        PageSpace::kDataFreelist * (FreeList::kNumLists + 1);
-    state.freelist_limit =
-        old_space->num_freelists_ * (FreeList::kNumLists + 1);
+    state.freelist_cursor = PageSpace::kDataFreelist * FreeList::kNumAllLists;
+    state.freelist_limit = old_space->num_freelists_ * FreeList::kNumAllLists;
 
     if (num_candidates == 0) return false;
   }
@@ -251,6 +282,12 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     for (intptr_t j = 0; j < FreeList::kNumLists; j++) {
       freelist->free_map_.Set(j, freelist->free_lists_[j] != nullptr);
     }
+    freelist->large_map_ = 0;
+    for (intptr_t j = 0; j < FreeList::kNumLargeLists; j++) {
+      if (freelist->free_lists_[FreeList::kNumLists + j] != nullptr) {
+        freelist->large_map_ |= 1u << j;
+      }
+    }
   }
 
   return true;
@@ -265,7 +302,7 @@ void GCIncrementalCompactor::CheckFreeLists(PageSpace* old_space) {
       Page* page = Page::Of(freelist->top_);
       ASSERT(!page->is_evacuation_candidate());
     }
-    for (intptr_t j = 0; j <= FreeList::kNumLists; j++) {
+    for (intptr_t j = 0; j < FreeList::kNumAllLists; j++) {
       FreeListElement* current = freelist->free_lists_[j];
       while (current != nullptr) {
         Page* page = Page::Of(reinterpret_cast<uword>(current));
@@ -583,6 +620,19 @@ class EpilogueState {
   void AddNewFreeSize(intptr_t size) { new_free_size_ += size; }
   intptr_t NewFreeSize() { return new_free_size_; }
 
+  void AddBytesEvacuated(intptr_t size) { bytes_evacuated_ += size; }
+  intptr_t BytesEvacuated() { return bytes_evacuated_; }
+
+  // Records when a task finished copying, so the copy phase can be timed
+  // separately from forwarding.
+  void EvacuateDone(int64_t micros) {
+    int64_t end = evacuate_end_micros_.load();
+    while ((micros > end) &&
+           !evacuate_end_micros_.compare_exchange_weak(end, micros)) {
+    }
+  }
+  int64_t EvacuateEndMicros() { return evacuate_end_micros_; }
+
  private:
   Page* evac_page_;
   StoreBufferBlock* block_;
@@ -596,6 +646,8 @@ class EpilogueState {
   RelaxedAtomic<bool> roots_slice_ = {true};
   RelaxedAtomic<bool> reset_progress_bars_slice_ = {true};
   RelaxedAtomic<intptr_t> new_free_size_ = {0};
+  RelaxedAtomic<intptr_t> bytes_evacuated_ = {0};
+  RelaxedAtomic<int64_t> evacuate_end_micros_ = {0};
 };
 
 class EpilogueTask : public SafepointTask {
@@ -732,6 +784,8 @@ class EpilogueTask : public SafepointTask {
 
     old_space_->ReleaseLock(freelist_);
     old_space_->usage_.used_in_words -= (bytes_evacuated >> kWordSizeLog2);
+    state_->AddBytesEvacuated(bytes_evacuated);
+    state_->EvacuateDone(OS::GetCurrentMonotonicMicros());
 #if defined(SUPPORT_TIMELINE)
     tbes.SetNumArguments(1);
     tbes.FormatArgument(0, "bytes_evacuated", "%" Pd, bytes_evacuated);
@@ -843,10 +897,21 @@ void GCIncrementalCompactor::Evacuate(PageSpace* old_space) {
     tasks.Append(new EpilogueTask(barrier, isolate_group, old_space,
                                   old_space->DataFreeList(i), &state));
   }
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   isolate_group->safepoint_handler()->RunTasks(&tasks);
 
   old_space->heap_->new_space()->set_freed_in_words(state.NewFreeSize() >>
                                                     kWordSizeLog2);
+
+  // Only the copy phase scales with the size of the evacuation set. The cost
+  // of forwarding pointers across the heap is paid whatever the set's size,
+  // so including it would make small evacuations look slow.
+  const int64_t micros = state.EvacuateEndMicros() - start;
+  const intptr_t words_evacuated = state.BytesEvacuated() >> kWordSizeLog2;
+  if ((words_evacuated > 0) && (micros > 0)) {
+    old_space->evacuate_words_per_micro_ =
+        Utils::Maximum<intptr_t>(1, words_evacuated / micros);
+  }
 }
 
 void GCIncrementalCompactor::CheckPostEvacuate(PageSpace* old_space) {
@@ -23,6 +23,10 @@ class GCIncrementalCompactor : public AllStatic {
   static bool Epilogue(PageSpace* old_space);
   static void Abort(PageSpace* old_space);
 
+  // The most live bytes to evacuate in one cycle, from the new-space size and
+  // the pause budget at the measured evacuation speed.
+  static intptr_t MaxEvacuatedBytes(PageSpace* old_space);
+
  private:
   static bool SelectEvacuationCandidates(PageSpace* old_space);
   static void CheckFreeLists(PageSpace* old_space);
@@ -42,7 +42,10 @@ class MarkingVisitor : public ObjectPointerVisitor {
         marked_micros_(0),
         concurrent_(true),
         has_evacuation_candidate_(false) {}
-  ~MarkingVisitor() { ASSERT(delayed_.IsEmpty()); }
+  ~MarkingVisitor() {
+    ASSERT(delayed_.IsEmpty());
+    ASSERT(prefetch_count_ == 0);
+  }
 
   uintptr_t marked_bytes() const { return marked_bytes_; }
   int64_t marked_micros() const { return marked_micros_; }
@@ -103,6 +106,9 @@ class MarkingVisitor : public ObjectPointerVisitor {
 
   DART_NOINLINE
   void YieldConcurrentMarking() {
+    // The scavenger may move the new-space objects waiting in the prefetch
+    // ring, so return them to the work lists where it can find them.
+    SpillPrefetched();
     old_work_list_.Flush();
     new_work_list_.Flush();
     tlab_deferred_work_list_.Flush();
@@ -129,7 +135,7 @@ class MarkingVisitor : public ObjectPointerVisitor {
     Thread* thread = Thread::Current();
     do {
       ObjectPtr obj;
-      while (MarkerWorkList::Pop(&old_work_list_, &new_work_list_, &obj)) {
+      while (PopPrefetched(&obj)) {
         ASSERT(!has_evacuation_candidate_);
 
         if (obj->IsNewObject()) {
@@ -162,6 +168,8 @@ class MarkingVisitor : public ObjectPointerVisitor {
           // Shape changing is not compatible with concurrent marking.
           deferred_work_list_.Push(obj);
           size = obj->untag()->HeapSize();
+        } else if (IsChunkedArray(obj, class_id)) {
+          size = VisitArrayChunk(static_cast<ArrayPtr>(obj));
         } else if (obj->untag()->IsCardRemembered()) {
           ASSERT((class_id == kArrayCid) || (class_id == kImmutableArrayCid));
           size = VisitCards(static_cast<ArrayPtr>(obj));
@@ -237,12 +245,79 @@ class MarkingVisitor : public ObjectPointerVisitor {
     return obj->untag()->HeapSize();
   }
 
+  // Large arrays are visited in chunks, one per pop, with the array pushed
+  // back onto the shared marking stack while chunks remain. Other marking tasks can then
+  // take the remaining chunks, so one huge array doesn't serialize the
+  // parallel marker or blow through the incremental marking budget.
+  static constexpr intptr_t kArrayChunkSlots = 128 * Page::kSlotsPerCard;
+
+  static bool IsChunkedArray(ObjectPtr obj, intptr_t class_id) {
+    if ((class_id != kArrayCid) && (class_id != kImmutableArrayCid)) {
+      return false;
+    }
+    ArrayPtr array = static_cast<ArrayPtr>(obj);
+    return (Smi::Value(array->untag()->length()) > kArrayChunkSlots) &&
+           Page::Of(array)->is_large();
+  }
+
+  intptr_t VisitArrayChunk(ArrayPtr obj) {
+    ASSERT(obj->IsArray() || obj->IsImmutableArray());
+    Page* page = Page::Of(obj);
+    ASSERT(page->is_large());
+    const intptr_t length = Smi::Value(obj->untag()->length());
+    const intptr_t chunk = page->ClaimMarkingChunk();
+    const intptr_t start = chunk * kArrayChunkSlots;
+    if (start >= length) {
+      return 0;  // Another task claimed the last chunk.
+    }
+    const intptr_t end = Utils::Minimum(start + kArrayChunkSlots, length);
+    if (end < length) {
+      // Published rather than kept in the local block, which other tasks
+      // would only see after it fills or is flushed.
+      old_work_list_.PushShared(obj);
+    }
+
+    // The first chunk also covers the type arguments.
+    CompressedObjectPtr* from =
+        chunk == 0 ? obj->untag()->from() : &obj->untag()->data()[start];
+    CompressedObjectPtr* to = &obj->untag()->data()[end - 1];
+    uword heap_base = obj.heap_base();
+    if (!obj->untag()->IsCardRemembered()) {
+      VisitCompressedPointers(heap_base, from, to);
+    } else {
+      // As in VisitCards, remember only the cards that point to evacuation
+      // candidates.
+      while (from <= to) {
+        const uword card_start = Utils::RoundDown(
+            reinterpret_cast<uword>(from), 1 << Page::kBytesPerCardLog2);
+        CompressedObjectPtr* card_to =
+            reinterpret_cast<CompressedObjectPtr*>(card_start) +
+            Page::kSlotsPerCard - 1;
+        if (card_to > to) {
+          card_to = to;
+        }
+        VisitCompressedPointers(heap_base, from, card_to);
+        if (has_evacuation_candidate_) {
+          has_evacuation_candidate_ = false;
+          page->RememberCard(from);
+        }
+        from = card_to + 1;
+      }
+    }
+
+    intptr_t size = (end - start) * kCompressedWordSize;
+    if (chunk == 0) {
+      size += obj->untag()->HeapSize() - length * kCompressedWordSize;
+    }
+    return size;
+  }
+
   void DrainMarkingStack() {
     ASSERT(!concurrent_);
     Thread* thread = Thread::Current();
     do {
       ObjectPtr obj;
-      while (MarkerWorkList::Pop(&old_work_list_, &new_work_list_, &obj)) {
+      while (PopPrefetched(&obj)) {
         ASSERT(!has_evacuation_candidate_);
 
         const intptr_t class_id = obj->GetClassIdOfHeapObject();
@@ -259,6 +334,8 @@ class MarkingVisitor : public ObjectPointerVisitor {
           size = ProcessWeakArray(static_cast<WeakArrayPtr>(obj));
         } else if (class_id == kFinalizerEntryCid) {
           size = ProcessFinalizerEntry(static_cast<FinalizerEntryPtr>(obj));
+        } else if (IsChunkedArray(obj, class_id)) {
+          size = VisitArrayChunk(static_cast<ArrayPtr>(obj));
         } else {
           if (obj->untag()->IsCardRemembered()) {
             ASSERT((class_id == kArrayCid) || (class_id == kImmutableArrayCid));
@@ -325,6 +402,8 @@ class MarkingVisitor : public ObjectPointerVisitor {
           // Shape changing is not compatible with concurrent marking.
           deferred_work_list_.Push(obj);
           size = obj->untag()->HeapSize();
+        } else if (IsChunkedArray(obj, class_id)) {
+          size = VisitArrayChunk(static_cast<ArrayPtr>(obj));
         } else {
           if ((class_id == kArrayCid) || (class_id == kImmutableArrayCid)) {
             size = obj->untag()->HeapSize();
@@ -609,6 +688,8 @@ class MarkingVisitor : public ObjectPointerVisitor {
   }
 
   void AbandonWork() {
+    prefetch_head_ = 0;
+    prefetch_count_ = 0;
     old_work_list_.AbandonWork();
     new_work_list_.AbandonWork();
     tlab_deferred_work_list_.AbandonWork();
@@ -631,6 +712,50 @@ class MarkingVisitor : public ObjectPointerVisitor {
   GCLinkedLists* delayed() { return &delayed_; }
 
  private:
+  // Popped objects wait in a small ring while their headers are prefetched,
+  // so the cache miss on an object overlaps with visiting the ones popped
+  // before it.
+  static constexpr intptr_t kPrefetchDepth = 8;
+
+  static DART_FORCE_INLINE void Prefetch(ObjectPtr obj) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(reinterpret_cast<void*>(UntaggedObject::ToAddr(obj)));
+#endif
+  }
+
+  DART_FORCE_INLINE
+  bool PopPrefetched(ObjectPtr* obj) {
+    while (prefetch_count_ < kPrefetchDepth) {
+      ObjectPtr next;
+      if (!MarkerWorkList::Pop(&old_work_list_, &new_work_list_, &next)) {
+        break;
+      }
+      Prefetch(next);
+      prefetch_[(prefetch_head_ + prefetch_count_) % kPrefetchDepth] = next;
+      prefetch_count_++;
+    }
+    if (prefetch_count_ == 0) {
+      return false;
+    }
+    *obj = prefetch_[prefetch_head_];
+    prefetch_head_ = (prefetch_head_ + 1) % kPrefetchDepth;
+    prefetch_count_--;
+    return true;
+  }
+
+  void SpillPrefetched() {
+    while (prefetch_count_ > 0) {
+      ObjectPtr obj = prefetch_[prefetch_head_];
+      prefetch_head_ = (prefetch_head_ + 1) % kPrefetchDepth;
+      prefetch_count_--;
+      if (obj->IsNewObject()) {
+        new_work_list_.Push(obj);
+      } else {
+        old_work_list_.Push(obj);
+      }
+    }
+  }
+
   DART_FORCE_INLINE
   bool MarkObject(ObjectPtr obj) {
     if (obj->IsImmediateObject()) {
@@ -697,6 +822,9 @@ class MarkingVisitor : public ObjectPointerVisitor {
   int64_t marked_micros_;
   bool concurrent_;
   bool has_evacuation_candidate_;
+  ObjectPtr prefetch_[kPrefetchDepth];
+  intptr_t prefetch_head_ = 0;
+  intptr_t prefetch_count_ = 0;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MarkingVisitor);
 };
@@ -115,6 +115,7 @@ Page* Page::Allocate(intptr_t size, uword flags) {
   result->survivor_end_ = 0;
   result->resolved_top_ = 0;
   result->live_bytes_ = 0;
+  result->marking_progress_ = 0;
 
   if ((flags & kNew) != 0) {
     uword top = result->object_start();
@@ -131,7 +132,23 @@ Page* Page::Allocate(intptr_t size, uword flags) {
   return result;
 }
 
+intptr_t Page::CacheLimit() {
+  // Allow caching up to one new-space worth of pages to avoid the cost unmap
+  // when freeing from-space. Using ThresholdInWords both accounts for
+  // new-space scaling with the number of mutators, and prevents the cache
+  // from staying big after new-space shrinks.
+  IsolateGroup* group = IsolateGroup::Current();
+  if (group == nullptr) {
+    return 0;
+  }
+  return group->heap()->new_space()->ThresholdInWords() / kPageSizeInWords;
+}
+
 void Page::Deallocate() {
+  Deallocate(((flags_ & kNew) != 0) ? CacheLimit() : 0);
+}
+
+void Page::Deallocate(intptr_t new_space_cache_limit) {
   if (is_image()) {
     delete memory_;
     // For a heap page from a snapshot, the Page object lives in the malloc
@@ -151,15 +168,7 @@ void Page::Deallocate() {
   if (CanUseCache(flags_)) {
     ASSERT(memory->size() == kPageSize);
 
-    // Allow caching up to one new-space worth of pages to avoid the cost unmap
-    // when freeing from-space. Using ThresholdInWords both accounts for
-    // new-space scaling with the number of mutators, and prevents the cache
-    // from staying big after new-space shrinks.
-    intptr_t limit = 0;
-    IsolateGroup* group = IsolateGroup::Current();
-    if ((group != nullptr) && ((flags_ & kNew) != 0)) {
-      limit = group->heap()->new_space()->ThresholdInWords() / kPageSizeInWords;
-    }
+    intptr_t limit = ((flags_ & kNew) != 0) ? new_space_cache_limit : 0;
     limit = Utils::Maximum(limit, FLAG_new_gen_semi_max_size * MB / kPageSize);
     limit = Utils::Minimum(limit, kPageCacheCapacity);
 
@@ -200,6 +200,11 @@ class Page {
                             bool only_marked = false);
   void ResetProgressBar();
 
+  // The marker splits large arrays into chunks so that several marking tasks
+  // can share them. Returns the index of the next unclaimed chunk.
+  intptr_t ClaimMarkingChunk() { return marking_progress_.fetch_add(1); }
+  void ResetMarkingProgress() { marking_progress_ = 0; }
+
   Thread* owner() const { return owner_; }
 
   // Remember the limit to which objects have been copied.
@@ -319,6 +324,16 @@ class Page {
   // page becomes immediately inaccessible.
   void Deallocate();
 
+  // As above, for threads outside the isolate group that owns this page.
+  // 'new_space_cache_limit' is the number of pages the page cache may hold
+  // when this is a new-space page, as 'CacheLimit' would compute it on a
+  // thread of the owning group.
+  void Deallocate(intptr_t new_space_cache_limit);
+
+  // The number of new-space pages the page cache may hold for the current
+  // isolate group.
+  static intptr_t CacheLimit();
+
   uword flags_;
   VirtualMemory* memory_;
   Page* next_;
@@ -346,6 +361,8 @@ class Page {
 
   RelaxedAtomic<intptr_t> live_bytes_;
 
+  RelaxedAtomic<intptr_t> marking_progress_;
+
   friend class CheckStoreBufferScavengeVisitor;
   friend class CheckStoreBufferEvacuateVisitor;
   friend class GCCompactor;
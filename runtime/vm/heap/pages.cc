@@ -38,6 +38,11 @@ DEFINE_FLAG(int,
             280,
             "The max number of pages the old generation can grow at a time");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(bool,
+            lazy_sweep,
+            true,
+            "Sweep pages on demand when old-space allocation fails during a "
+            "concurrent sweep instead of waiting for the sweep to finish.");
 
 // The initial estimate of how many words we can mark per microsecond (usage
 // before / mark-sweep time). This is a conservative value observed running
@@ -45,6 +50,10 @@ DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
 // based on the device's actual speed.
 static constexpr intptr_t kConservativeInitialMarkSpeed = 20;
 
+// With a pause goal, never start concurrent marking before this percentage of
+// the allowed growth has been used, or old-space GCs become too frequent.
+static constexpr int kMinMarkStartPercent = 50;
+
 PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
     : heap_(heap),
       num_freelists_(Scavenger::NumDataFreelists() + 1),
@@ -70,6 +79,7 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       gc_time_micros_(0),
       collections_(0),
       mark_words_per_micro_(kConservativeInitialMarkSpeed),
+      evacuate_words_per_micro_(0),
       enable_concurrent_mark_(FLAG_concurrent_mark) {
   ASSERT(heap != nullptr);
 
@@ -712,6 +722,12 @@ void PageSpace::ResetProgressBars() const {
   }
 }
 
+void PageSpace::ResetMarkingProgress() const {
+  for (Page* page = large_pages_; page != nullptr; page = page->next()) {
+    page->ResetMarkingProgress();
+  }
+}
+
 void PageSpace::WriteProtect(bool read_only) {
   if (read_only) {
     // Avoid MakeIterable trying to write to the heap.
@@ -724,6 +740,19 @@ void PageSpace::WriteProtect(bool read_only) {
   }
 }
 
+static intptr_t CountPages(Page* page) {
+  intptr_t count = 0;
+  for (; page != nullptr; page = page->next()) {
+    count++;
+  }
+  return count;
+}
+
+intptr_t PageSpace::UnsweptPageCount() const {
+  MutexLocker ml(&pages_lock_);
+  return CountPages(sweep_regular_) + CountPages(sweep_large_);
+}
+
 #ifndef PRODUCT
 void PageSpace::PrintToJSONObject(JSONObject* object) const {
   auto isolate_group = IsolateGroup::Current();
@@ -750,6 +779,33 @@ void PageSpace::PrintToJSONObject(JSONObject* object) const {
   }
 }
 
+static const char* PhaseName(PageSpace::Phase phase) {
+  switch (phase) {
+    case PageSpace::kDone:
+      return "done";
+    case PageSpace::kMarking:
+      return "marking";
+    case PageSpace::kAwaitingFinalization:
+      return "awaitingFinalization";
+    case PageSpace::kSweepingLarge:
+      return "sweepingLarge";
+    case PageSpace::kSweepingRegular:
+      return "sweepingRegular";
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+void PageSpace::PrintSweepStateToJSONObject(JSONObject* object) const {
+  MutexLocker ml(&pages_lock_);
+  object->AddProperty("_oldSpacePhase", PhaseName(phase()));
+  object->AddProperty("_sweptPages", CountPages(pages_));
+  object->AddProperty("_unsweptPages", CountPages(sweep_regular_));
+  object->AddProperty("_sweptLargePages", CountPages(large_pages_));
+  object->AddProperty("_unsweptLargePages", CountPages(sweep_large_));
+  object->AddProperty("_executablePages", CountPages(exec_pages_));
+}
+
 class HeapMapAsJSONVisitor : public ObjectVisitor {
  public:
   explicit HeapMapAsJSONVisitor(JSONArray* array) : array_(array) {}
@@ -1055,6 +1111,7 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
   // Mark all reachable old-gen objects.
   if (marker_ == nullptr) {
     ASSERT(phase() == kDone);
+    ResetMarkingProgress();
     marker_ = new GCMarker(isolate_group, heap_);
     if (FLAG_use_incremental_compactor) {
       GCIncrementalCompactor::Prologue(this);
@@ -1401,8 +1458,6 @@ void PageSpace::SweepLarge() {
 void PageSpace::Sweep(bool exclusive) {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "Sweep");
 
-  GCSweeper sweeper;
-
   intptr_t shard = 0;
   const intptr_t num_shards = heap_->new_space()->NumScavengeWorkers();
   ASSERT(num_shards < num_freelists_);
@@ -1424,26 +1479,8 @@ void PageSpace::Sweep(bool exclusive) {
     // evenly distributed among the freelists and so roughly evenly available
     // to each scavenger worker.
     shard = (shard + 1) % num_shards;
-    FreeList* freelist = DataFreeList(shard);
-    if (!exclusive) {
-      freelist->mutex()->Lock();
-    }
-    bool page_in_use = sweeper.SweepPage(page, freelist);
-    if (!exclusive) {
-      freelist->mutex()->Unlock();
-    }
-    intptr_t size;
-    if (!page_in_use) {
-      size = page->memory_->size();
-      page->Deallocate();
-    }
+    SweepRegularPage(page, DataFreeList(shard), /*lock_freelist=*/!exclusive);
     ml.Lock();
-
-    if (page_in_use) {
-      AddPageLocked(page);
-    } else {
-      IncreaseCapacityInWordsLocked(-(size >> kWordSizeLog2));
-    }
   }
 
   if (exclusive) {
@@ -1453,11 +1490,61 @@ void PageSpace::Sweep(bool exclusive) {
   }
 }
 
+void PageSpace::SweepRegularPage(Page* page,
+                                 FreeList* freelist,
+                                 bool lock_freelist) {
+  GCSweeper sweeper;
+  if (lock_freelist) {
+    freelist->mutex()->Lock();
+  }
+  bool page_in_use = sweeper.SweepPage(page, freelist);
+  if (lock_freelist) {
+    freelist->mutex()->Unlock();
+  }
+  intptr_t size;
+  if (!page_in_use) {
+    size = page->memory_->size();
+    page->Deallocate();
+  }
+
+  MutexLocker ml(&pages_lock_);
+  if (page_in_use) {
+    AddPageLocked(page);
+  } else {
+    IncreaseCapacityInWordsLocked(-(size >> kWordSizeLog2));
+  }
+}
+
+bool PageSpace::SweepNextPage() {
+  if (!FLAG_lazy_sweep) {
+    return false;
+  }
+  Page* page;
+  {
+    MutexLocker ml(&pages_lock_);
+    page = sweep_regular_;
+    if (page == nullptr) {
+      return false;
+    }
+    sweep_regular_ = page->next();
+    page->set_next(nullptr);
+  }
+  // The mutator allocates from the first data freelist, so that is where the
+  // free space of this page is needed.
+  SweepRegularPage(page, DataFreeList(), /*lock_freelist=*/true);
+  return true;
+}
+
 void PageSpace::ConcurrentSweep(IsolateGroup* isolate_group) {
   // Start the concurrent sweeper task now.
   GCSweeper::SweepConcurrent(isolate_group);
 }
 
+void PageSpace::SetGCTimeGoal(intptr_t percent) {
+  page_space_controller_.set_garbage_collection_time_ratio(
+      percent != 0 ? percent : FLAG_old_gen_growth_time_ratio);
+}
+
 void PageSpace::Compact(Thread* thread) {
   GCCompactor compactor(thread, heap_);
   compactor.Compact(pages_, &freelists_[kDataFreelist], &pages_lock_);
@@ -1562,6 +1649,7 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   page->survivor_end_ = 0;
   page->resolved_top_ = 0;
   page->live_bytes_ = 0;
+  page->marking_progress_ = 0;
 
   MutexLocker ml(&pages_lock_);
   page->next_ = image_pages_;
@@ -1630,6 +1718,18 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   ASSERT(end >= start);
   history_.AddGarbageCollectionTime(start, end);
   const int gc_time_fraction = history_.GarbageCollectionTimeFraction();
+  const int garbage_collection_time_ratio = garbage_collection_time_ratio_;
+
+  const int64_t max_pause_micros =
+      (heap_ != nullptr) ? heap_->max_pause_micros() : 0;
+  if (max_pause_micros == 0) {
+    mark_start_percent_ = 100;
+  } else if ((end - start) > max_pause_micros) {
+    mark_start_percent_ =
+        Utils::Maximum(kMinMarkStartPercent, mark_start_percent_ - 10);
+  } else if (2 * (end - start) < max_pause_micros) {
+    mark_start_percent_ = Utils::Minimum(100, mark_start_percent_ + 10);
+  }
 
   // Assume garbage increases linearly with allocation:
   // G = kA, and estimate k from the previous cycle.
@@ -1660,10 +1760,10 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
       // growth_in_pages size based on estimated garbage so we use growth ratio
       // heuristics instead.
       growth_in_pages = growth_ratio_heuristic;
-    } else if (garbage_collection_time_ratio_ == 0) {
+    } else if (garbage_collection_time_ratio == 0) {
       // Exclude time from the growth policy decision for --deterministic.
       growth_in_pages = growth_ratio_heuristic;
-    } else if (gc_time_fraction <= garbage_collection_time_ratio_) {
+    } else if (gc_time_fraction <= garbage_collection_time_ratio) {
       // Stick with the ratio hueristic when we're staying under the desired
       // time fraction.
       growth_in_pages = growth_ratio_heuristic;
@@ -1672,8 +1772,8 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
       // garbage.
       double t = 1.0 - desired_utilization_;
       // If we spend too much time in GC, strive for even more free space.
-      if (gc_time_fraction > garbage_collection_time_ratio_) {
-        t += (gc_time_fraction - garbage_collection_time_ratio_) / 100.0;
+      if (gc_time_fraction > garbage_collection_time_ratio) {
+        t += (gc_time_fraction - garbage_collection_time_ratio) / 100.0;
       }
 
       // Find minimum 'growth_in_pages' such that after increasing capacity by
@@ -1766,7 +1866,9 @@ void PageSpaceController::RecordUpdate(SpaceUsage before,
 
   bool concurrent_mark = FLAG_concurrent_mark && (FLAG_marker_tasks != 0);
   if (concurrent_mark) {
-    soft_gc_threshold_in_words_ = threshold;
+    soft_gc_threshold_in_words_ =
+        after.CombinedUsedInWords() +
+        (kPageSizeInWords * growth_in_pages * mark_start_percent_) / 100;
     hard_gc_threshold_in_words_ = kIntptrMax / kWordSize;
   } else {
     soft_gc_threshold_in_words_ = kIntptrMax / kWordSize;
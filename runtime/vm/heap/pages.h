@@ -80,6 +80,10 @@ class PageSpaceController {
   void EvaluateAfterLoading(SpaceUsage after);
 
   void set_last_usage(SpaceUsage current) { last_usage_ = current; }
+  void set_garbage_collection_time_ratio(int value) {
+    garbage_collection_time_ratio_ = value;
+  }
+  int mark_start_percent() const { return mark_start_percent_; }
 
  private:
   friend class PageSpace;  // For MergeOtherPageSpaceController
@@ -108,7 +112,14 @@ class PageSpaceController {
 
   // If the relative GC time goes above garbage_collection_time_ratio_ %,
   // we grow the heap more aggressively.
-  const int garbage_collection_time_ratio_;
+  RelaxedAtomic<int> garbage_collection_time_ratio_;
+
+  // With a pause goal (Dart_SetGCGoals), concurrent marking starts once this
+  // percentage of the growth allowed since the last GC has been used. It is
+  // lowered while mark-sweep pauses exceed the goal, so that more of the work
+  // happens concurrently, and raised again once they are comfortably within
+  // it.
+  int mark_start_percent_ = 100;
 
   // Perform a stop-the-world GC when usage exceeds this amount.
   intptr_t hard_gc_threshold_in_words_;
@@ -183,6 +194,12 @@ class PageSpace {
   bool ReachedIdleThreshold() const {
     return page_space_controller_.ReachedIdleThreshold(usage_);
   }
+  // See Dart_SetGCGoals. Zero restores --old_gen_growth_time_ratio.
+  void SetGCTimeGoal(intptr_t percent);
+  int mark_start_percent() const {
+    return page_space_controller_.mark_start_percent();
+  }
+
   void EvaluateAfterLoading() {
     page_space_controller_.EvaluateAfterLoading(usage_);
 
@@ -238,6 +255,7 @@ class PageSpace {
 
   void VisitRememberedCards(PredicateObjectPointerVisitor* visitor) const;
   void ResetProgressBars() const;
+  void ResetMarkingProgress() const;
 
   // Collect the garbage in the page space using mark-sweep or mark-compact.
   void CollectGarbage(Thread* thread, bool compact, bool finalize);
@@ -255,6 +273,13 @@ class PageSpace {
   void IncrementalMarkWithTimeBudget(int64_t deadline);
   void AssistTasks(MonitorLocker* ml);
 
+  // Sweeps one regular page still waiting for the concurrent sweeper, so an
+  // allocation can be satisfied without waiting for the whole sweep. Returns
+  // false if there are no unswept pages left.
+  bool SweepNextPage();
+  // Regular and large pages not yet swept since the last marking.
+  intptr_t UnsweptPageCount() const;
+
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
   int64_t gc_time_micros() const { return gc_time_micros_; }
@@ -263,8 +288,16 @@ class PageSpace {
 
   intptr_t collections() const { return collections_; }
 
+  intptr_t evacuate_words_per_micro() const {
+    return evacuate_words_per_micro_;
+  }
+  void set_evacuate_words_per_micro(intptr_t value) {
+    evacuate_words_per_micro_ = value;
+  }
+
 #ifndef PRODUCT
   void PrintToJSONObject(JSONObject* object) const;
+  void PrintSweepStateToJSONObject(JSONObject* object) const;
   void PrintHeapMapToJSONStream(IsolateGroup* isolate_group,
                                 JSONStream* stream) const;
 #endif  // PRODUCT
@@ -421,6 +454,7 @@ class PageSpace {
   void SweepNew();
   void SweepLarge();
   void Sweep(bool exclusive);
+  void SweepRegularPage(Page* page, FreeList* freelist, bool lock_freelist);
   void ConcurrentSweep(IsolateGroup* isolate_group);
   void Compact(Thread* thread);
 
@@ -495,6 +529,8 @@ class PageSpace {
   int64_t gc_time_micros_;
   intptr_t collections_;
   intptr_t mark_words_per_micro_;
+  // Measured by the incremental compactor; zero until its first evacuation.
+  intptr_t evacuate_words_per_micro_;
 
   bool enable_concurrent_mark_;
 
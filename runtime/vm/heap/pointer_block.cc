@@ -269,6 +269,210 @@ void BlockStack<BlockSize>::VisitObjectPointers(ObjectPointerVisitor* visitor) {
   }
 }
 
+PromotionStack::~PromotionStack() {
+  SetNumWorkers(0);
+}
+
+void PromotionStack::SetNumWorkers(intptr_t num_workers) {
+  if (num_workers == num_deques_) {
+    return;
+  }
+  for (intptr_t i = 0; i < num_deques_; i++) {
+    ASSERT(deques_[i]->IsEmpty());
+    delete deques_[i];
+  }
+  delete[] deques_;
+  deques_ = nullptr;
+  num_deques_ = num_workers;
+  if (num_workers > 0) {
+    deques_ = new Deque*[num_workers];
+    for (intptr_t i = 0; i < num_workers; i++) {
+      deques_[i] = new Deque();
+    }
+  }
+}
+
+PromotionStack::Block* PromotionStack::StealBlock(intptr_t thief) {
+  // Start with the next worker so thieves spread out over their victims.
+  for (intptr_t i = 1; i < num_deques_; i++) {
+    Block* block;
+    if (deques_[(thief + i) % num_deques_]->Steal(&block)) {
+      return block;
+    }
+  }
+  return nullptr;
+}
+
+void PromotionStack::NotifyPushed() {
+  // Pairs with the fence in WaitForStolenWork: either the sleeper sees the
+  // pushed block, or this sees the sleeper.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_sleeping_.load(std::memory_order_relaxed) > 0) {
+    MonitorLocker ml(&monitor_);
+    ml.Notify();
+  }
+}
+
+bool PromotionStack::HasStealableWork(intptr_t thief) const {
+  for (intptr_t i = 1; i < num_deques_; i++) {
+    if (!deques_[(thief + i) % num_deques_]->IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Idle workers spin this many times trying to steal before they sleep until
+// a block is pushed or all workers are idle.
+static constexpr intptr_t kStealSpinRounds = 64;
+
+PromotionStack::Block* PromotionStack::WaitForStolenWork(
+    intptr_t worker,
+    RelaxedAtomic<uintptr_t>* num_busy,
+    bool abort) {
+  if (num_busy->fetch_sub(1u) == 1 /* 1 is before subtraction */) {
+    // This is the last worker, wake the others now that we know no further work
+    // will come.
+    MonitorLocker ml(&monitor_);
+    ml.NotifyAll();
+    return nullptr;
+  }
+  if (abort) {
+    return nullptr;
+  }
+  // Owners only push while busy and only go idle once their deque is empty,
+  // and a thief counts itself as busy before it steals. So once num_busy
+  // reaches zero there is no work left anywhere.
+  for (intptr_t round = 0;; round++) {
+    if (num_busy->load() == 0) {
+      return nullptr;
+    }
+    num_busy->fetch_add(1u);
+    Block* block = StealBlock(worker);
+    if (block != nullptr) {
+      return block;
+    }
+    if (num_busy->fetch_sub(1u) == 1) {
+      MonitorLocker ml(&monitor_);
+      ml.NotifyAll();
+      return nullptr;
+    }
+    if (round >= kStealSpinRounds) {
+      MonitorLocker ml(&monitor_);
+      num_sleeping_.fetch_add(1, std::memory_order_relaxed);
+      // Pairs with the fence in NotifyPushed.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if ((num_busy->load() != 0) && !HasStealableWork(worker)) {
+        ml.Wait();
+      }
+      num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void PromotionStack::FlushDeques() {
+  for (intptr_t i = 0; i < num_deques_; i++) {
+    Block* block;
+    while (deques_[i]->Pop(&block)) {
+      PushBlock(block);
+    }
+  }
+}
+
+PromotionWorkList::PromotionWorkList(PromotionStack* stack, intptr_t worker)
+    : stack_(stack),
+      deque_(stack->num_workers() > 0 ? stack->DequeAt(worker) : nullptr),
+      worker_(worker) {
+  local_output_ = stack_->PopEmptyBlock();
+  local_input_ = stack_->PopEmptyBlock();
+}
+
+PromotionWorkList::Block* PromotionWorkList::PopNonEmptyBlock() {
+  if (deque_ == nullptr) {
+    return stack_->PopNonEmptyBlock();
+  }
+  Block* block;
+  if (deque_->Pop(&block)) {
+    return block;
+  }
+  return stack_->StealBlock(worker_);
+}
+
+PromotionWorkList::Block* PromotionWorkList::PopEmptyBlock() {
+  if (empty_ != nullptr) {
+    Block* block = empty_;
+    empty_ = block->next();
+    block->set_next(nullptr);
+    return block;
+  }
+  return stack_->PopEmptyBlock();
+}
+
+void PromotionWorkList::PushFullBlock(Block* block) {
+  if (deque_ == nullptr) {
+    stack_->PushBlock(block);
+  } else {
+    deque_->Push(block);
+    stack_->NotifyPushed();
+  }
+}
+
+void PromotionWorkList::RecycleBlock(Block* block) {
+  ASSERT(block->IsEmpty());
+  if (deque_ == nullptr) {
+    stack_->PushBlock(block);
+  } else {
+    block->set_next(empty_);
+    empty_ = block;
+  }
+}
+
+void PromotionWorkList::ReleaseEmptyBlocks() {
+  while (empty_ != nullptr) {
+    Block* block = empty_;
+    empty_ = block->next();
+    block->set_next(nullptr);
+    stack_->PushBlock(block);
+  }
+}
+
+bool PromotionWorkList::WaitForWork(RelaxedAtomic<uintptr_t>* num_busy,
+                                    bool abort) {
+  ASSERT(local_input_->IsEmpty() || abort);
+  Block* new_work =
+      (deque_ == nullptr)
+          ? stack_->WaitForWork(num_busy, abort)
+          : stack_->WaitForStolenWork(worker_, num_busy, abort);
+  if (new_work == nullptr) {
+    return false;
+  }
+  RecycleBlock(local_input_);
+  local_input_ = new_work;
+  return true;
+}
+
+void PromotionWorkList::Finalize() {
+  ASSERT(local_output_->IsEmpty());
+  stack_->PushBlock(local_output_);
+  local_output_ = nullptr;
+  ASSERT(local_input_->IsEmpty());
+  stack_->PushBlock(local_input_);
+  local_input_ = nullptr;
+  ASSERT((deque_ == nullptr) || deque_->IsEmpty());
+  ReleaseEmptyBlocks();
+  // Fail fast on attempts to promote after finalizing.
+  stack_ = nullptr;
+}
+
+void PromotionWorkList::AbandonWork() {
+  stack_->PushBlock(local_output_);
+  local_output_ = nullptr;
+  stack_->PushBlock(local_input_);
+  local_input_ = nullptr;
+  ReleaseEmptyBlocks();
+  stack_ = nullptr;
+}
+
 template <int BlockSize>
 void BlockStack<BlockSize>::TrimGlobalEmpty() {
   DEBUG_ASSERT(global_mutex_->IsOwnedByCurrentThread());
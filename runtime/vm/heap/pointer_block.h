@@ -5,10 +5,13 @@
 #ifndef RUNTIME_VM_HEAP_POINTER_BLOCK_H_
 #define RUNTIME_VM_HEAP_POINTER_BLOCK_H_
 
+#include <atomic>
+
 #include "platform/assert.h"
 #include "vm/globals.h"
 #include "vm/os_thread.h"
 #include "vm/tagged_pointer.h"
+#include "vm/work_stealing_deque.h"
 
 namespace dart {
 
@@ -224,6 +227,14 @@ class BlockWorkList : public ValueObject {
     local_output_->Push(raw_obj);
   }
 
+  // Pushes the object in a block of its own directly onto the shared stack,
+  // where other workers can take it without waiting for a flush.
+  void PushShared(ObjectPtr raw_obj) {
+    Block* block = stack_->PopEmptyBlock();
+    block->Push(raw_obj);
+    stack_->PushBlock(block);
+  }
+
   void Flush() {
     if (!local_output_->IsEmpty()) {
       stack_->PushBlock(local_output_);
@@ -319,14 +330,135 @@ typedef BlockWorkList<MarkingStack> MarkerWorkList;
 static constexpr int kPromotionStackBlockSize = 64;
 class PromotionStack : public BlockStack<kPromotionStackBlockSize> {
  public:
+  typedef WorkStealingDeque<Block*> Deque;
+
+  PromotionStack() {}
+  ~PromotionStack();
+
   // Adds and transfers ownership of the block to the buffer.
   void PushBlock(Block* block) {
     BlockStack<Block::kSize>::PushBlockImpl(block);
   }
+
+  // Gives each of |num_workers| scavenger workers its own deque of full
+  // blocks, which the other workers steal from when they run out of work.
+  // With zero workers, all blocks go through the shared lists of the stack.
+  // Must not be called while any worker is running.
+  void SetNumWorkers(intptr_t num_workers);
+  intptr_t num_workers() const { return num_deques_; }
+  Deque* DequeAt(intptr_t worker) const {
+    ASSERT((worker >= 0) && (worker < num_deques_));
+    return deques_[worker];
+  }
+
+  // Takes a block from the deque of any worker other than |thief|, or
+  // returns nullptr if none was found.
+  Block* StealBlock(intptr_t thief);
+
+  // The work-stealing counterpart to WaitForWork: marks |worker| as idle and
+  // steals from the other workers until either a block is found (returned,
+  // with |worker| busy again) or all workers are idle (returns nullptr).
+  Block* WaitForStolenWork(intptr_t worker,
+                           RelaxedAtomic<uintptr_t>* num_busy,
+                           bool abort);
+
+  // Moves blocks left in the deques of aborted workers to the shared lists,
+  // where Reset will discard them.
+  void FlushDeques();
+
+  // Called by a worker after pushing to its deque, to wake a worker that has
+  // stopped spinning in WaitForStolenWork.
+  void NotifyPushed();
+
+ private:
+  bool HasStealableWork(intptr_t thief) const;
+
+  Deque** deques_ = nullptr;
+  intptr_t num_deques_ = 0;
+  // Workers waiting on the monitor in WaitForStolenWork.
+  std::atomic<intptr_t> num_sleeping_ = {0};
+
+  DISALLOW_COPY_AND_ASSIGN(PromotionStack);
 };
 
 typedef PromotionStack::Block PromotionStackBlock;
-typedef BlockWorkList<PromotionStack> PromotionWorkList;
+
+// A scavenger worker's view of the PromotionStack. Like BlockWorkList, it
+// buffers one input and one output block locally. If the stack has
+// per-worker deques, full blocks are pushed to and popped from this worker's
+// deque without locking, emptied blocks are recycled locally, and only an
+// idle worker touches the deques of other workers.
+class PromotionWorkList : public ValueObject {
+ public:
+  typedef PromotionStack::Block Block;
+
+  PromotionWorkList(PromotionStack* stack, intptr_t worker);
+  ~PromotionWorkList() {
+    ASSERT(local_output_ == nullptr);
+    ASSERT(local_input_ == nullptr);
+    ASSERT(stack_ == nullptr);
+  }
+
+  // Returns false if no more work was found.
+  DART_FORCE_INLINE
+  bool Pop(ObjectPtr* object) {
+    ASSERT(local_input_ != nullptr);
+    if (UNLIKELY(local_input_->IsEmpty())) {
+      if (!local_output_->IsEmpty()) {
+        auto temp = local_output_;
+        local_output_ = local_input_;
+        local_input_ = temp;
+      } else {
+        Block* new_work = PopNonEmptyBlock();
+        if (new_work == nullptr) {
+          return false;
+        }
+        RecycleBlock(local_input_);
+        local_input_ = new_work;
+      }
+    }
+    *object = local_input_->Pop();
+    return true;
+  }
+
+  void Push(ObjectPtr raw_obj) {
+    if (UNLIKELY(local_output_->IsFull())) {
+      PushFullBlock(local_output_);
+      local_output_ = PopEmptyBlock();
+    }
+    local_output_->Push(raw_obj);
+  }
+
+  bool WaitForWork(RelaxedAtomic<uintptr_t>* num_busy, bool abort = false);
+
+  void Finalize();
+  void AbandonWork();
+
+  bool IsEmpty() {
+    if (!local_input_->IsEmpty() || !local_output_->IsEmpty()) {
+      return false;
+    }
+    return (deque_ != nullptr) ? deque_->IsEmpty() : stack_->IsEmpty();
+  }
+
+ private:
+  Block* PopNonEmptyBlock();
+  Block* PopEmptyBlock();
+  void PushFullBlock(Block* block);
+  void RecycleBlock(Block* block);
+  void ReleaseEmptyBlocks();
+
+  Block* local_output_;
+  Block* local_input_;
+  PromotionStack* stack_;
+  // Null unless work stealing.
+  PromotionStack::Deque* deque_;
+  intptr_t worker_;
+  // Emptied blocks kept for reuse, linked through next().
+  Block* empty_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(PromotionWorkList);
+};
 
 template <int Size, typename T>
 class LocalBlockWorkList : public ValueObject {
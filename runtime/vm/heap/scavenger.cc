@@ -31,6 +31,7 @@
 #include "vm/stack_frame.h"
 #include "vm/tagged_pointer.h"
 #include "vm/thread_barrier.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
 
@@ -46,6 +47,33 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(bool,
+            scavenger_work_stealing,
+            true,
+            "Give each parallel scavenger worker its own deque of promoted "
+            "objects to visit, which idle workers steal from, instead of one "
+            "shared list.");
+DEFINE_FLAG(bool,
+            pretenure,
+            false,
+            "Promote instances of classes that nearly always survive their "
+            "first scavenge without copying them within new gen first.");
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            85,
+            "Pretenure a class when more than this percentage of its sampled "
+            "new gen allocations survive their first scavenge.");
+DEFINE_FLAG(int,
+            pretenure_sample_pages,
+            2,
+            "The number of new gen pages sampled per scavenge to measure "
+            "per-class survival rates.");
+DEFINE_FLAG(bool,
+            concurrent_scavenge_release,
+            true,
+            "In latency performance mode, release from-space pages on a helper "
+            "thread instead of inside the scavenge pause. Objects are still "
+            "evacuated inside the pause.");
 
 // Scavenger uses the kCardRememberedBit to distinguish forwarded and
 // non-forwarded objects. We must choose a bit that is clear for all new-space
@@ -133,7 +161,8 @@ class ScavengerVisitor : public ObjectPointerVisitor,
                             Scavenger* scavenger,
                             SemiSpace* from,
                             FreeList* freelist,
-                            PromotionStack* promotion_stack)
+                            PromotionStack* promotion_stack,
+                            intptr_t worker)
       : ObjectPointerVisitor(isolate_group),
         thread_(nullptr),
         scavenger_(scavenger),
@@ -143,7 +172,7 @@ class ScavengerVisitor : public ObjectPointerVisitor,
         bytes_promoted_(0),
         visiting_old_object_(nullptr),
         pending_(nullptr),
-        promoted_list_(promotion_stack) {}
+        promoted_list_(promotion_stack, worker) {}
   ~ScavengerVisitor() { ASSERT(pending_ == nullptr); }
 
 #ifdef DEBUG
@@ -450,16 +479,19 @@ class ScavengerVisitor : public ObjectPointerVisitor,
     } else {
       intptr_t size = obj->untag()->HeapSize(header);
       ASSERT(IsAllocatableInNewSpace(size));
+      intptr_t cid = UntaggedObject::ClassIdTag::decode(header);
       uword new_addr = 0;
       // Check whether object should be promoted.
-      if (!Page::Of(obj)->IsSurvivor(raw_addr)) {
+      if (!Page::Of(obj)->IsSurvivor(raw_addr) &&
+          !scavenger_->ShouldPretenure(cid)) {
         // Not a survivor of a previous scavenge. Just copy the object into the
         // to space.
         new_addr = TryAllocateCopy(size);
       }
       if (new_addr == 0) {
-        // This object is a survivor of a previous scavenge. Attempt to promote
-        // the object. (Or, unlikely, to-space was exhausted by fragmentation.)
+        // This object is a survivor of a previous scavenge or of a pretenured
+        // class. Attempt to promote the object. (Or, unlikely, to-space was
+        // exhausted by fragmentation.)
         new_addr = page_space_->TryAllocatePromoLocked(freelist_, size);
         if (UNLIKELY(new_addr == 0)) {
           // Promotion did not succeed. Copy into the to space instead.
@@ -486,7 +518,6 @@ class ScavengerVisitor : public ObjectPointerVisitor,
         new_obj->untag()->tags_.store(tags, std::memory_order_relaxed);
       }
 
-      intptr_t cid = UntaggedObject::ClassIdTag::decode(header);
       if (IsTypedDataClassId(cid)) {
         static_cast<TypedDataPtr>(new_obj)->untag()->RecomputeDataField();
       }
@@ -725,6 +756,16 @@ SemiSpace::~SemiSpace() {
   }
 }
 
+void SemiSpace::DeallocatePages(intptr_t cache_limit) {
+  Page* page = head_;
+  while (page != nullptr) {
+    Page* next = page->next();
+    page->Deallocate(cache_limit);
+    page = next;
+  }
+  head_ = tail_ = nullptr;
+}
+
 Page* SemiSpace::TryAllocatePageLocked(bool link) {
   if (capacity_in_words_ >= gc_threshold_in_words_) {
     return nullptr;  // Full.
@@ -799,8 +840,11 @@ Scavenger::Scavenger(Heap* heap, intptr_t max_semi_capacity_in_words)
 }
 
 Scavenger::~Scavenger() {
+  WaitForReleaseTasks();
   delete to_;
   ASSERT(blocks_ == nullptr);
+  free(survival_stats_);
+  free(pretenured_);
 }
 
 intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
@@ -838,6 +882,25 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
   // Align to TLAB size.
   limit = Utils::RoundDown(limit, kPageSizeInWords);
 
+  const int64_t max_pause_micros = heap_->max_pause_micros();
+  if ((max_pause_micros > 0) && (stats_history_.Size() != 0)) {
+    // Scavenge time is dominated by survivors, whose volume tends to grow with
+    // new-space. Don't grow if that would likely exceed the pause goal, and
+    // shrink while the last scavenge exceeded it.
+    const int64_t last_pause_micros = stats_history_.Get(0).DurationMicros();
+    const intptr_t min_size_in_words = 2 * num_mutators * kPageSizeInWords;
+    if ((last_pause_micros > max_pause_micros) &&
+        (old_size_in_words > min_size_in_words)) {
+      return Utils::Maximum(
+          Utils::RoundDown(old_size_in_words / 2, kPageSizeInWords),
+          min_size_in_words);
+    }
+    if (grow && (old_size_in_words >= min_size_in_words) &&
+        (FLAG_new_gen_growth_factor * last_pause_micros > max_pause_micros)) {
+      grow = false;
+    }
+  }
+
   intptr_t growth_factor = grow ? FLAG_new_gen_growth_factor : 1;
   return Utils::Minimum(old_size_in_words * growth_factor, limit);
 }
@@ -1122,13 +1185,177 @@ void Scavenger::Epilogue(SemiSpace* from) {
     VerifyStoreBuffers("Verifying remembered set after Scavenge");
   }
 
-  delete from;
+  ReleaseFromSpace(from);
   UpdateMaxHeapUsage();
   if (heap_ != nullptr) {
     heap_->UpdateGlobalMaxUsed();
   }
 }
 
+class ReleaseSemiSpaceTask : public ThreadPool::Task {
+ public:
+  ReleaseSemiSpaceTask(Scavenger* scavenger,
+                       SemiSpace* space,
+                       intptr_t cache_limit)
+      : scavenger_(scavenger), space_(space), cache_limit_(cache_limit) {}
+
+  virtual void Run() {
+    // This thread has no isolate group, so the page cache limit was computed
+    // by the mutator.
+    space_->DeallocatePages(cache_limit_);
+    delete space_;
+    scavenger_->ReleaseTaskDone();
+  }
+
+ private:
+  Scavenger* scavenger_;
+  SemiSpace* space_;
+  intptr_t cache_limit_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReleaseSemiSpaceTask);
+};
+
+void Scavenger::ReleaseFromSpace(SemiSpace* from) {
+  // Nothing references from-space once the scavenge has finished, so in
+  // latency mode returning its pages to the page cache or the OS (and the
+  // TLB shootdowns of unmapping them) can overlap with the mutators.
+  //
+  // This is the only part of a scavenge that runs outside the pause.
+  // Evacuation itself is still stop-the-world in every performance mode:
+  // copying concurrently with the mutators would need a read barrier or
+  // forwarding indirection on every load of a possibly-new object, which
+  // neither the compilers nor the runtime emit.
+  if (FLAG_concurrent_scavenge_release && (from->head() != nullptr) &&
+      (heap_->mode() == Dart_PerformanceMode_Latency)) {
+    {
+      MonitorLocker ml(&release_lock_);
+      release_tasks_++;
+    }
+    const intptr_t cache_limit = ThresholdInWords() / kPageSizeInWords;
+    if (Dart::thread_pool()->Run<ReleaseSemiSpaceTask>(this, from,
+                                                      cache_limit)) {
+      return;
+    }
+    MonitorLocker ml(&release_lock_);
+    release_tasks_--;
+  }
+  delete from;
+}
+
+void Scavenger::ReleaseTaskDone() {
+  MonitorLocker ml(&release_lock_);
+  ASSERT(release_tasks_ > 0);
+  release_tasks_--;
+  ml.NotifyAll();
+}
+
+void Scavenger::WaitForReleaseTasks() {
+  MonitorLocker ml(&release_lock_);
+  while (release_tasks_ > 0) {
+    ml.Wait();
+  }
+}
+
+// Classes with less recent sampled allocation than this are not pretenured:
+// there is too little evidence either way.
+static constexpr intptr_t kMinPretenureSampleInWords = 512;
+
+// A pretenured class is only demoted once its survival rate falls this far
+// below the threshold, to avoid flip-flopping around it.
+static constexpr double kPretenureHysteresis = 0.1;
+
+bool Scavenger::SampleSurvival(SemiSpace* from) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "SampleSurvival");
+
+  const intptr_t num_cids = heap_->isolate_group()->class_table()->NumCids();
+  if (survival_stats_length_ < num_cids) {
+    survival_stats_ = reinterpret_cast<ClassSurvivalStats*>(
+        realloc(survival_stats_, num_cids * sizeof(ClassSurvivalStats)));
+    for (intptr_t i = survival_stats_length_; i < num_cids; i++) {
+      survival_stats_[i] = ClassSurvivalStats();
+    }
+    survival_stats_length_ = num_cids;
+  }
+
+  // Only objects allocated since the previous scavenge tell us whether their
+  // class survives its first scavenge. Survivors of the previous scavenge sit
+  // at the start of their page and are skipped.
+  intptr_t pages_sampled = 0;
+  for (Page* page = from->head();
+       (page != nullptr) && (pages_sampled < FLAG_pretenure_sample_pages);
+       page = page->next()) {
+    bool sampled = false;
+    uword addr = page->object_start();
+    const uword end = page->object_end();
+    while (addr < end) {
+      ObjectPtr obj = UntaggedObject::FromAddr(addr);
+      uword header = ReadHeaderRelaxed(obj);
+      const bool survived = IsForwarding(header);
+      if (survived) {
+        // Promotion only updates the age bits, so the copy's header has the
+        // same class id and size.
+        header = ReadHeaderRelaxed(ForwardedObj(header));
+      }
+      const intptr_t size = obj->untag()->HeapSize(header);
+      const intptr_t cid = UntaggedObject::ClassIdTag::decode(header);
+      if (!page->IsSurvivor(addr) && (cid < survival_stats_length_)) {
+        ClassSurvivalStats* stats = &survival_stats_[cid];
+        stats->allocated_in_words += size >> kWordSizeLog2;
+        if (survived) {
+          stats->survived_in_words += size >> kWordSizeLog2;
+        }
+        sampled = true;
+      }
+      addr += size;
+    }
+    if (sampled) {
+      pages_sampled++;
+    }
+  }
+  return pages_sampled > 0;
+}
+
+void Scavenger::UpdatePretenuring() {
+  if (pretenured_length_ < survival_stats_length_) {
+    pretenured_ = reinterpret_cast<bool*>(
+        realloc(pretenured_, survival_stats_length_ * sizeof(bool)));
+    for (intptr_t i = pretenured_length_; i < survival_stats_length_; i++) {
+      pretenured_[i] = false;
+    }
+    pretenured_length_ = survival_stats_length_;
+  }
+
+  const double threshold = FLAG_pretenure_threshold / 100.0;
+  intptr_t num_pretenured = 0;
+  for (intptr_t cid = 0; cid < survival_stats_length_; cid++) {
+    ClassSurvivalStats* stats = &survival_stats_[cid];
+    if (stats->allocated_in_words < kMinPretenureSampleInWords) {
+      // Includes classes whose instances are now all allocated in old-space
+      // by the runtime: they fall back to new-space to be measured again.
+      pretenured_[cid] = false;
+    } else {
+      double survival = stats->survived_in_words /
+                        static_cast<double>(stats->allocated_in_words);
+      if (survival > threshold) {
+        pretenured_[cid] = true;
+      } else if (survival < (threshold - kPretenureHysteresis)) {
+        pretenured_[cid] = false;
+      }
+    }
+    if (pretenured_[cid]) {
+      num_pretenured++;
+    }
+    // Older scavenges are given half as much weight.
+    stats->allocated_in_words /= 2;
+    stats->survived_in_words /= 2;
+  }
+
+  if (FLAG_verbose_gc && (num_pretenured != num_pretenured_)) {
+    OS::PrintErr("Pretenuring %" Pd " classes\n", num_pretenured);
+  }
+  num_pretenured_ = num_pretenured;
+}
+
 bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline) {
   // To make a consistent decision, we should not yield for a safepoint in the
   // middle of deciding whether to perform an idle GC.
@@ -1887,12 +2114,14 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
 
   IsolateGroup* isolate_group = heap_->isolate_group();
 
+  promotion_stack_.SetNumWorkers(
+      (FLAG_scavenger_work_stealing && (num_tasks > 1)) ? num_tasks : 0);
   ScavengerVisitor** visitors = new ScavengerVisitor*[num_tasks];
   IntrusiveDList<SafepointTask> tasks;
   for (intptr_t i = 0; i < num_tasks; i++) {
     FreeList* freelist = heap_->old_space()->DataFreeList(i);
     visitors[i] = new ScavengerVisitor(isolate_group, this, from, freelist,
-                                       &promotion_stack_);
+                                       &promotion_stack_, i);
     tasks.Append(
         new ScavengerTask(isolate_group, barrier, visitors[i], &num_busy));
   }
@@ -1910,9 +2139,13 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   delete[] visitors;
 
   if (abort_) {
+    promotion_stack_.FlushDeques();
     ReverseScavenge(&from);
     bytes_promoted = 0;
   } else {
+    if (FLAG_pretenure && SampleSurvival(from)) {
+      UpdatePretenuring();
+    }
     if ((ThresholdInWords() - UsedInWords()) < 32 * KBInWords) {
       // Don't scavenge again until the next old-space GC has occurred. Prevents
       // performing one scavenge per allocation as the heap limit is approached.
@@ -1926,6 +2159,7 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   stats_history_.Add(ScavengeStats(
       start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
       bytes_promoted >> kWordSizeLog2, abandoned_bytes >> kWordSizeLog2));
+  heap_->gc_statistics()->RecordPromotion(bytes_promoted);
   Epilogue(from);
   heap_->old_space()->ResumeConcurrentMarking();
 
@@ -2091,6 +2325,7 @@ void Scavenger::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("used", UsedInWords() * kWordSize);
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
+  space.AddProperty("pretenuredClasses", NumPretenuredClasses());
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
 }
 #endif  // !PRODUCT
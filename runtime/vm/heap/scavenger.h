@@ -57,6 +57,10 @@ class SemiSpace {
 
   void AddList(Page* head, Page* tail);
 
+  // Deallocates all pages, allowing the page cache to grow to 'cache_limit'
+  // pages. Used by threads outside the isolate group.
+  void DeallocatePages(intptr_t cache_limit);
+
  private:
   // Size of Pages in this semi-space.
   intptr_t capacity_in_words_ = 0;
@@ -120,6 +124,13 @@ class ScavengeStats {
   intptr_t abandoned_in_words_;
 };
 
+// Survival feedback for a single class, accumulated from sampled from-space
+// pages and decayed by half after every scavenge.
+struct ClassSurvivalStats {
+  intptr_t allocated_in_words = 0;
+  intptr_t survived_in_words = 0;
+};
+
 class Scavenger {
  private:
   static constexpr intptr_t kTLABSize = 512 * KB;
@@ -247,6 +258,18 @@ class Scavenger {
   intptr_t NumScavengeWorkers();
   static intptr_t NumDataFreelists();
 
+  // Whether nearly all instances of this class survive their first scavenge.
+  // Such instances are promoted the first time they are found to be live
+  // instead of being copied within new-space first, and allocations from the
+  // runtime go directly to old-space. Only changes at a safepoint.
+  bool ShouldPretenure(intptr_t cid) const {
+    return (cid < pretenured_length_) && pretenured_[cid];
+  }
+  intptr_t NumPretenuredClasses() const { return num_pretenured_; }
+
+  // Blocks until from-spaces handed to helper threads have been released.
+  void WaitForReleaseTasks();
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -287,9 +310,14 @@ class Scavenger {
   void MournWeakHandles();
   void MournWeakTables();
   void Epilogue(SemiSpace* from);
+  void ReleaseFromSpace(SemiSpace* from);
+  void ReleaseTaskDone();
 
   void VerifyStoreBuffers(const char* msg);
 
+  bool SampleSurvival(SemiSpace* from);
+  void UpdatePretenuring();
+
   void UpdateMaxHeapCapacity();
   void UpdateMaxHeapUsage();
 
@@ -315,6 +343,14 @@ class Scavenger {
   static constexpr int kStatsHistoryCapacity = 4;
   RingBuffer<ScavengeStats, kStatsHistoryCapacity> stats_history_;
 
+  // Indexed by class id. Sized lazily to the class table when pretenuring is
+  // enabled.
+  ClassSurvivalStats* survival_stats_ = nullptr;
+  intptr_t survival_stats_length_ = 0;
+  bool* pretenured_ = nullptr;
+  intptr_t pretenured_length_ = 0;
+  intptr_t num_pretenured_ = 0;
+
   intptr_t scavenge_words_per_micro_;
   intptr_t idle_scavenge_threshold_in_words_ = 0;
 
@@ -328,7 +364,12 @@ class Scavenger {
   // Protects new space during the allocation of new TLABs
   mutable Mutex space_lock_;
 
+  // Counts from-spaces still being released by ReleaseSemiSpaceTasks.
+  Monitor release_lock_;
+  intptr_t release_tasks_ = 0;
+
   friend class ScavengerVisitor;
+  friend class ReleaseSemiSpaceTask;
 
   DISALLOW_COPY_AND_ASSIGN(Scavenger);
 };
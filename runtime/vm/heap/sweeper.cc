@@ -114,6 +114,8 @@ bool GCSweeper::SweepPage(Page* page, FreeList* freelist) {
           cursor += kWordSize;
         }
       } else if (UNLIKELY(dontneed_on_sweep)) {
+        // Not combined with --transparent_huge_pages (see Dart::DartInit):
+        // these ranges lie within a heap page and would split huge pages.
         uword page_aligned_start = Utils::RoundUp(
             current + FreeListElement::kLargeHeaderSize, page_size);
         uword page_aligned_end = Utils::RoundDown(free_end, page_size);
@@ -182,6 +184,7 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
       Thread* thread = Thread::Current();
       ASSERT(thread->BypassSafepoints());  // Or we should be checking in.
       TIMELINE_FUNCTION_GC_DURATION(thread, "ConcurrentSweep");
+      const int64_t start = OS::GetCurrentMonotonicMicros();
 
       old_space->SweepLarge();
 
@@ -193,6 +196,8 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
       }
 
       old_space->Sweep(/*exclusive*/ false);
+      isolate_group_->heap()->gc_statistics()->RecordConcurrentSweep(
+          OS::GetCurrentMonotonicMicros() - start);
     }
     // Exit isolate cleanly *before* notifying it, to avoid shutdown race.
     Thread::ExitIsolateGroupAsNonMutator();
@@ -91,6 +91,12 @@ DEFINE_FLAG_HANDLER(DeterministicModeHandler,
                     deterministic,
                     "Enable deterministic mode.");
 
+DEFINE_FLAG(int,
+            isolate_spawn_pool_size,
+            0,
+            "Number of isolates each isolate group creates ahead of time for "
+            "Isolate.spawn once it is first used.");
+
 DEFINE_FLAG(bool,
             disable_thread_pool_limit,
             false,
@@ -366,6 +372,9 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       handler_info_cache_(),
       catch_entry_moves_cache_() {
   FlagsCopyFrom(api_flags);
+  if (!is_vm_isolate && !is_system_isolate_group_) {
+    isolate_pool_size_ = FLAG_isolate_spawn_pool_size;
+  }
   if (!is_vm_isolate) {
     intptr_t max_worker_threads;
     if (FLAG_disable_thread_pool_limit) {
@@ -451,8 +460,10 @@ bool IsolateGroup::ContainsOnlyOneIsolate() {
   SafepointReadRwLocker ml(Thread::Current(), isolates_lock_.get());
   // We do allow 0 here as well, because the background compiler might call
   // this method while the mutator thread is in shutdown procedure and
-  // unregistered itself already.
-  return isolate_count_ == 0 || isolate_count_ == 1;
+  // unregistered itself already. Pooled isolates are not counted: they run
+  // no Dart code, and are taken from the pool under the write lock.
+  const intptr_t count = isolate_count_ - pooled_isolate_count_;
+  return count == 0 || count == 1;
 }
 
 void IsolateGroup::UnregisterIsolate(Isolate* isolate) {
@@ -471,6 +482,110 @@ bool IsolateGroup::UnregisterIsolateDecrementCount() {
   return isolate_count_ == 0;
 }
 
+intptr_t IsolateGroup::IsolatePoolDeficit() {
+  MutexLocker ml(&isolate_pool_mutex_);
+  return Utils::Maximum<intptr_t>(
+      0, isolate_pool_size_ - isolate_pool_.length());
+}
+
+bool IsolateGroup::AddPooledIsolate(Isolate* isolate) {
+  ASSERT(isolate->group() == this);
+  ASSERT(!isolate->is_runnable());
+  MutexLocker ml(&isolate_pool_mutex_);
+  if (isolate_pool_.length() >= isolate_pool_size_) {
+    return false;
+  }
+  SafepointWriteRwLocker wl(Thread::Current(), isolates_lock_.get());
+  isolate_pool_.Add(isolate);
+  pooled_isolate_count_++;
+  return true;
+}
+
+Isolate* IsolateGroup::TakePooledIsolate() {
+  MutexLocker ml(&isolate_pool_mutex_);
+  if (isolate_pool_.is_empty()) {
+    return nullptr;
+  }
+  SafepointWriteRwLocker wl(Thread::Current(), isolates_lock_.get());
+  pooled_isolate_count_--;
+  return isolate_pool_.RemoveLast();
+}
+
+// Shuts down the pooled isolates that no longer fit in the pool, which the
+// isolate lowering its size cannot enter itself. Its outstanding spawn keeps
+// the group alive until they are gone.
+class TrimIsolatePoolTask : public ThreadPool::Task {
+ public:
+  explicit TrimIsolatePoolTask(Isolate* isolate) : isolate_(isolate) {}
+
+  virtual void Run() {
+    isolate_->group()->TrimIsolatePool();
+    isolate_->DecrementSpawnCount();
+  }
+
+ private:
+  Isolate* isolate_;
+};
+
+void IsolateGroup::SetIsolatePoolSize(intptr_t size) {
+  ASSERT(size >= 0);
+  const bool shrinking = size < isolate_pool_size_;
+  isolate_pool_size_ = size;
+  if (!shrinking) {
+    return;
+  }
+  Isolate* isolate = Isolate::Current();
+  ASSERT(isolate->group() == this);
+  isolate->IncrementSpawnCount();
+  if (!Dart::thread_pool()->Run<TrimIsolatePoolTask>(isolate)) {
+    isolate->DecrementSpawnCount();
+  }
+}
+
+void IsolateGroup::TrimIsolatePool() {
+  ASSERT(Isolate::Current() == nullptr);
+  MallocGrowableArray<Isolate*> excess;
+  {
+    MutexLocker ml(&isolate_pool_mutex_);
+    SafepointWriteRwLocker wl(Thread::Current(), isolates_lock_.get());
+    while (isolate_pool_.length() > isolate_pool_size_) {
+      excess.Add(isolate_pool_.RemoveLast());
+      pooled_isolate_count_--;
+    }
+  }
+  for (intptr_t i = 0; i < excess.length(); i++) {
+    Dart_EnterIsolate(Api::CastIsolate(excess[i]));
+    Dart_ShutdownIsolate();
+  }
+}
+
+bool IsolateGroup::ShutdownIsolatePoolIfIdle() {
+  ASSERT(Isolate::Current() == nullptr);
+  MallocGrowableArray<Isolate*> pool;
+  {
+    MutexLocker ml(&isolate_pool_mutex_);
+    if (isolate_pool_.is_empty()) {
+      return false;
+    }
+    SafepointWriteRwLocker wl(Thread::Current(), isolates_lock_.get());
+    // Pooled isolates are only added by isolates spawning from this group,
+    // which keep it alive until they are done.
+    if (isolate_count_ != isolate_pool_.length()) {
+      return false;
+    }
+    while (!isolate_pool_.is_empty()) {
+      pool.Add(isolate_pool_.RemoveLast());
+    }
+    pooled_isolate_count_ = 0;
+  }
+  // The last of these isolates to shut down also shuts down the group.
+  for (intptr_t i = 0; i < pool.length(); i++) {
+    Dart_EnterIsolate(Api::CastIsolate(pool[i]));
+    Dart_ShutdownIsolate();
+  }
+  return true;
+}
+
 void IsolateGroup::CreateHeap(bool is_vm_isolate,
                               bool is_service_or_kernel_isolate) {
   Heap::Init(this, is_vm_isolate,
@@ -2693,6 +2808,11 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
   }
 
   const bool shutdown_group = isolate_group->UnregisterIsolateDecrementCount();
+  if (!shutdown_group && !is_vm_isolate &&
+      isolate_group->ShutdownIsolatePoolIfIdle()) {
+    // The isolate group may be gone.
+    return;
+  }
   if (shutdown_group) {
     KernelIsolate::NotifyAboutIsolateGroupShutdown(isolate_group);
 
@@ -3851,8 +3971,11 @@ bool Isolate::HasLivePorts() {
   return open_ports_keepalive_ > 0;
 }
 
-ReceivePortPtr Isolate::CreateReceivePort(const String& debug_name) {
-  Dart_Port port_id = PortMap::CreatePort(message_handler());
+ReceivePortPtr Isolate::CreateReceivePort(const String& debug_name,
+                                          intptr_t capacity,
+                                          bool block_senders) {
+  Dart_Port port_id =
+      PortMap::CreatePort(message_handler(), capacity, block_senders);
   ++open_ports_;
   ++open_ports_keepalive_;
   return ReceivePort::New(port_id, debug_name);
@@ -326,6 +326,30 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 
   bool ContainsOnlyOneIsolate();
 
+  // The number of isolates this group creates ahead of time, so that
+  // Isolate.spawn can start them without waiting for their creation.
+  intptr_t isolate_pool_size() const { return isolate_pool_size_; }
+  // Must be called by an isolate of this group. If the size is lowered, the
+  // pooled isolates that no longer fit are shut down on another thread.
+  void SetIsolatePoolSize(intptr_t size);
+
+  // Returns the number of isolates missing from the pool.
+  intptr_t IsolatePoolDeficit();
+  // Adds a new, not yet runnable isolate of this group which no thread has
+  // entered. Returns false if the pool is full.
+  bool AddPooledIsolate(Isolate* isolate);
+  // Takes an isolate added by [AddPooledIsolate], or returns nullptr.
+  Isolate* TakePooledIsolate();
+  // Shuts down the pooled isolates beyond the pool size.
+  //
+  // Must be called without a current isolate.
+  void TrimIsolatePool();
+  // Shuts down the pooled isolates if they are the only isolates left in the
+  // group. Returns true if it did, after which the group may be gone.
+  //
+  // Must be called without a current isolate.
+  bool ShutdownIsolatePoolIfIdle();
+
   Dart_Port interrupt_port() { return interrupt_port_; }
 
   ThreadRegistry* thread_registry() const { return thread_registry_.get(); }
@@ -861,6 +885,12 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   IntrusiveDList<Isolate> isolates_;
   RelaxedAtomic<Dart_Port> interrupt_port_ = ILLEGAL_PORT;
   intptr_t isolate_count_ = 0;
+  // The registered isolates that are in [isolate_pool_], guarded by
+  // [isolates_lock_] like [isolate_count_].
+  intptr_t pooled_isolate_count_ = 0;
+  Mutex isolate_pool_mutex_;
+  MallocGrowableArray<Isolate*> isolate_pool_;
+  RelaxedAtomic<intptr_t> isolate_pool_size_ = 0;
   bool initial_spawn_successful_ = false;
   Dart_LibraryTagHandler library_tag_handler_ = nullptr;
   Dart_DeferredLoadHandler deferred_load_handler_ = nullptr;
@@ -1293,7 +1323,11 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
   bool HasOpenNativeCallables();
 
   bool HasLivePorts();
-  ReceivePortPtr CreateReceivePort(const String& debug_name);
+  // Opens a port for this isolate, bounded to [capacity] waiting messages if
+  // it is positive. See [PortMap::CreatePort].
+  ReceivePortPtr CreateReceivePort(const String& debug_name,
+                                   intptr_t capacity = 0,
+                                   bool block_senders = false);
   void SetReceivePortKeepAliveState(const ReceivePort& receive_port,
                                     bool keep_isolate_alive);
   void CloseReceivePort(const ReceivePort& receive_port);
@@ -93,9 +93,13 @@ MessageQueue::~MessageQueue() {
   // Ensure that all pending messages have been released.
   Clear();
   ASSERT(head_ == nullptr);
+  ASSERT(inbox_.load(std::memory_order_relaxed) == nullptr);
 }
 
 void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
+  // Keep messages from [EnqueueConcurrently] ahead of this one.
+  DrainInbox();
+
   // TODO(mdempsky): Use unique_ptr internally?
   Message* msg = msg0.release();
 
@@ -139,7 +143,47 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
   }
 }
 
+bool MessageQueue::EnqueueConcurrently(std::unique_ptr<Message> msg0) {
+  Message* msg = msg0.release();
+
+  // Make sure messages are not reused.
+  ASSERT(msg->next_ == nullptr);
+  Message* head = inbox_.load(std::memory_order_relaxed);
+  do {
+    msg->next_ = head;
+  } while (!inbox_.compare_exchange_weak(head, msg, std::memory_order_release,
+                                         std::memory_order_relaxed));
+  return head == nullptr;
+}
+
+void MessageQueue::DrainInbox() {
+  // Pairs with the release in [EnqueueConcurrently].
+  Message* cur = inbox_.exchange(nullptr, std::memory_order_acquire);
+  if (cur == nullptr) {
+    return;
+  }
+  // Reverse the inbox into arrival order.
+  Message* last = cur;
+  Message* first = nullptr;
+  while (cur != nullptr) {
+    Message* next = cur->next_;
+    cur->next_ = first;
+    first = cur;
+    cur = next;
+  }
+  if (head_ == nullptr) {
+    ASSERT(tail_ == nullptr);
+    head_ = first;
+  } else {
+    tail_->next_ = first;
+  }
+  tail_ = last;
+}
+
 std::unique_ptr<Message> MessageQueue::Dequeue() {
+  if (head_ == nullptr) {
+    DrainInbox();
+  }
   Message* result = head_;
   if (result != nullptr) {
     head_ = result->next_;
@@ -156,6 +200,7 @@ std::unique_ptr<Message> MessageQueue::Dequeue() {
 }
 
 void MessageQueue::Clear() {
+  DrainInbox();
   std::unique_ptr<Message> cur(head_);
   head_ = nullptr;
   tail_ = nullptr;
@@ -165,14 +210,15 @@ void MessageQueue::Clear() {
   }
 }
 
-MessageQueue::Iterator::Iterator(const MessageQueue* queue) : next_(nullptr) {
+MessageQueue::Iterator::Iterator(MessageQueue* queue) : next_(nullptr) {
   Reset(queue);
 }
 
 MessageQueue::Iterator::~Iterator() {}
 
-void MessageQueue::Iterator::Reset(const MessageQueue* queue) {
+void MessageQueue::Iterator::Reset(MessageQueue* queue) {
   ASSERT(queue != nullptr);
+  queue->DrainInbox();
   next_ = queue->head_;
 }
 
@@ -188,7 +234,7 @@ Message* MessageQueue::Iterator::Next() {
   return current;
 }
 
-intptr_t MessageQueue::Length() const {
+intptr_t MessageQueue::Length() {
   MessageQueue::Iterator it(this);
   intptr_t length = 0;
   while (it.HasNext()) {
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_H_
 #define RUNTIME_VM_MESSAGE_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -128,6 +129,11 @@ class Message {
 
   intptr_t Id() const;
 
+  // Whether this message counts towards the capacity of a bounded port, see
+  // [PortMap::CreatePort].
+  bool counted_by_port() const { return counted_by_port_; }
+  void set_counted_by_port() { counted_by_port_ = true; }
+
   static const char* PriorityAsString(Priority priority);
 
  private:
@@ -151,11 +157,14 @@ class Message {
   intptr_t snapshot_length_ = 0;
   MessageFinalizableData* finalizable_data_ = nullptr;
   Priority priority_;
+  bool counted_by_port_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(Message);
 };
 
 // There is a message queue per isolate.
+//
+// Except for [EnqueueConcurrently], the queue is guarded by its owner's lock.
 class MessageQueue {
  public:
   MessageQueue();
@@ -163,11 +172,24 @@ class MessageQueue {
 
   void Enqueue(std::unique_ptr<Message> msg, bool before_events);
 
+  // Appends a message without holding the lock guarding the queue, and
+  // concurrently with other threads doing the same.
+  //
+  // The message is pushed onto a lock-free inbox, which the other operations
+  // move to the tail of the queue. Returns true if the inbox was empty, in
+  // which case the caller has to wake up the consumer of the queue.
+  bool EnqueueConcurrently(std::unique_ptr<Message> msg);
+
   // Gets the next message from the message queue or nullptr if no
   // message is available.  This function will not block.
   std::unique_ptr<Message> Dequeue();
 
-  bool IsEmpty() { return head_ == nullptr; }
+  bool IsEmpty() {
+    if (head_ == nullptr) {
+      DrainInbox();
+    }
+    return head_ == nullptr;
+  }
 
   // Clear all messages from the message queue.
   void Clear();
@@ -175,10 +197,10 @@ class MessageQueue {
   // Iterator class.
   class Iterator : public ValueObject {
    public:
-    explicit Iterator(const MessageQueue* queue);
+    explicit Iterator(MessageQueue* queue);
     virtual ~Iterator();
 
-    void Reset(const MessageQueue* queue);
+    void Reset(MessageQueue* queue);
 
     // Returns false when there are no more messages left.
     bool HasNext();
@@ -190,7 +212,7 @@ class MessageQueue {
     Message* next_;
   };
 
-  intptr_t Length() const;
+  intptr_t Length();
 
   // Returns the message with id or nullptr.
   Message* FindMessageById(intptr_t id);
@@ -198,9 +220,15 @@ class MessageQueue {
   void PrintJSON(JSONStream* stream);
 
  private:
+  // Moves the messages in [inbox_] to the tail of the queue.
+  void DrainInbox();
+
   Message* head_;
   Message* tail_;
 
+  // Messages added by [EnqueueConcurrently], most recent first.
+  std::atomic<Message*> inbox_ = {nullptr};
+
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
 
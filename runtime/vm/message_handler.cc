@@ -121,36 +121,50 @@ bool MessageHandler::Run(ThreadPool* pool,
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
+  const Message::Priority saved_priority = message->priority();
+
+  // Normal messages skip the monitor unless they are the first to arrive
+  // since the handler last looked at its queue. Only such a message can find
+  // the handler idle or waiting, and the handler cannot go idle before it has
+  // taken the messages arriving after it.
+  if (!message->IsOOB() && !before_events && !FLAG_trace_isolates) {
+    if (!queue_->EnqueueConcurrently(std::move(message))) {
+      MessageNotify(saved_priority);
+      return;
+    }
+  }
 
   {
     MonitorLocker ml(&monitor_);
-    if (FLAG_trace_isolates) {
-      Isolate* source_isolate = Isolate::Current();
-      if (source_isolate != nullptr) {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd "\n\tsource:     (%" Pd64
-            ") %s\n\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), static_cast<int64_t>(source_isolate->main_port()),
-            source_isolate->name(), name(), message->dest_port());
-      } else {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd
-            "\n\tsource:     <native code>\n"
-            "\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), name(), message->dest_port());
+    // Unless it was already enqueued above.
+    if (message != nullptr) {
+      if (FLAG_trace_isolates) {
+        Isolate* source_isolate = Isolate::Current();
+        if (source_isolate != nullptr) {
+          OS::PrintErr(
+              "[>] Posting message:\n"
+              "\tlen:        %" Pd "\n\tsource:     (%" Pd64
+              ") %s\n\tdest:       %s\n"
+              "\tdest_port:  %" Pd64 "\n",
+              message->Size(),
+              static_cast<int64_t>(source_isolate->main_port()),
+              source_isolate->name(), name(), message->dest_port());
+        } else {
+          OS::PrintErr(
+              "[>] Posting message:\n"
+              "\tlen:        %" Pd
+              "\n\tsource:     <native code>\n"
+              "\tdest:       %s\n"
+              "\tdest_port:  %" Pd64 "\n",
+              message->Size(), name(), message->dest_port());
+        }
       }
-    }
 
-    saved_priority = message->priority();
-    if (message->IsOOB()) {
-      oob_queue_->Enqueue(std::move(message), before_events);
-    } else {
-      queue_->Enqueue(std::move(message), before_events);
+      if (message->IsOOB()) {
+        oob_queue_->Enqueue(std::move(message), before_events);
+      } else {
+        queue_->Enqueue(std::move(message), before_events);
+      }
     }
     if (paused_for_messages_) {
       ml.Notify();
@@ -174,6 +188,9 @@ std::unique_ptr<Message> MessageHandler::DequeueMessage(
   if ((message == nullptr) && (min_priority < Message::kOOBPriority)) {
     message = queue_->Dequeue();
   }
+  if ((message != nullptr) && message->counted_by_port()) {
+    PortMap::OnMessageDequeued(*message);
+  }
   return message;
 }
 
@@ -374,6 +391,24 @@ bool MessageHandler::HasMessages() {
   return !queue_->IsEmpty();
 }
 
+intptr_t MessageHandler::QueuedMessages(Dart_Port port) {
+  MonitorLocker ml(&monitor_);
+  intptr_t count = 0;
+  MessageQueue::Iterator it(queue_);
+  while (it.HasNext()) {
+    if (it.Next()->dest_port() == port) {
+      count++;
+    }
+  }
+  it.Reset(oob_queue_);
+  while (it.HasNext()) {
+    if (it.Next()->dest_port() == port) {
+      count++;
+    }
+  }
+  return count;
+}
+
 void MessageHandler::TaskCallback() {
   ASSERT(Isolate::Current() == nullptr);
   MessageStatus status = kOK;
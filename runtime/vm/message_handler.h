@@ -82,6 +82,8 @@ class MessageHandler : public PortHandler {
   // handler.
   bool HasMessages();
 
+  intptr_t QueuedMessages(Dart_Port port) override;
+
   // Whether to keep this message handler alive or whether it should shutdown.
   virtual bool KeepAliveLocked() { return true; }
 
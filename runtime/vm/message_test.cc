@@ -4,6 +4,9 @@
 
 #include "vm/message.h"
 #include "platform/assert.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
+#include "vm/os_thread.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -140,4 +143,67 @@ TEST_CASE(MessageQueue_Clear) {
   EXPECT(queue.IsEmpty());
 }
 
+struct EnqueueMessagesData {
+  MessageQueue* queue;
+  Dart_Port port;
+  intptr_t count;
+  Monitor monitor;
+  bool done = false;
+};
+
+static void EnqueueMessages(uword parameter) {
+  auto data = reinterpret_cast<EnqueueMessagesData*>(parameter);
+  for (intptr_t i = 0; i < data->count; i++) {
+    data->queue->EnqueueConcurrently(
+        Message::New(data->port, Smi::New(i), Message::kNormalPriority));
+  }
+  MonitorLocker ml(&data->monitor);
+  data->done = true;
+  ml.Notify();
+}
+
+// Messages from each producer arrive in order, and none is lost while the
+// consumer takes messages concurrently.
+TEST_CASE(MessageQueue_EnqueueConcurrently) {
+  const intptr_t kProducers = 4;
+  const intptr_t kCount = 10000;
+  MessageQueue queue;
+  EXPECT(queue.EnqueueConcurrently(
+      Message::New(1, Smi::New(0), Message::kNormalPriority)));
+  EXPECT(!queue.EnqueueConcurrently(
+      Message::New(1, Smi::New(1), Message::kNormalPriority)));
+  EXPECT_EQ(2, queue.Length());
+  queue.Clear();
+
+  EnqueueMessagesData data[kProducers];
+  for (intptr_t i = 0; i < kProducers; i++) {
+    data[i].queue = &queue;
+    data[i].port = i + 1;
+    data[i].count = kCount;
+    OSThread::Start("EnqueueMessages", EnqueueMessages,
+                    reinterpret_cast<uword>(&data[i]));
+  }
+
+  intptr_t received[kProducers] = {};
+  intptr_t total = 0;
+  while (total < kProducers * kCount) {
+    std::unique_ptr<Message> message = queue.Dequeue();
+    if (message == nullptr) {
+      OS::Sleep(1);
+      continue;
+    }
+    const intptr_t producer = message->dest_port() - 1;
+    EXPECT_EQ(received[producer], Smi::Value(Smi::RawCast(message->raw_obj())));
+    received[producer]++;
+    total++;
+  }
+  EXPECT(queue.IsEmpty());
+  for (intptr_t i = 0; i < kProducers; i++) {
+    MonitorLocker ml(&data[i].monitor);
+    while (!data[i].done) {
+      ml.Wait();
+    }
+  }
+}
+
 }  // namespace dart
@@ -6,14 +6,18 @@
 
 #include <memory>
 
+#include "vm/dart.h"
 #include "vm/dart_api_state.h"
 #include "vm/flags.h"
+#include "vm/heap/page.h"
 #include "vm/heap/weak_table.h"
+#include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 
 #define Z zone_
@@ -102,6 +106,16 @@ DEFINE_FLAG(bool,
             gc_on_foc_slow_path,
             false,
             "Cause a GC when falling off the fast path for fast object copy.");
+DEFINE_FLAG(int,
+            object_copy_helper_threads,
+            0,
+            "Number of helper threads that copy large arrays and typed data "
+            "of messages together with the sending thread.");
+DEFINE_FLAG(bool,
+            preserve_hashes_in_object_copy,
+            false,
+            "Give copied objects the identity hash codes of the originals, so "
+            "that copied maps and sets keyed by them need not be rehashed.");
 
 const char* kFastAllocationFailed = "fast allocation failed";
 
@@ -313,11 +327,152 @@ void InitializeExternalTypedData(intptr_t cid,
   raw_to->data_ = buffer;
 }
 
+// Work on a large object that is split into chunks, some of which are done
+// by helper tasks on the VM thread pool.
+//
+// Helpers do not enter the isolate group. The copying thread must not check
+// into safepoints until [Run] returns, so that the objects involved can
+// neither move nor be collected while helpers access them.
+class ParallelCopyWork {
+ public:
+  virtual ~ParallelCopyWork() {}
+
+  virtual void CopyChunk(intptr_t chunk) = 0;
+
+  // Copies all [num_chunks] chunks of [work] on the current thread and up to
+  // [FLAG_object_copy_helper_threads] helpers.
+  static void Run(ParallelCopyWork* work, intptr_t num_chunks);
+};
+
+class ParallelCopyState {
+ public:
+  ParallelCopyState(ParallelCopyWork* work, intptr_t num_chunks)
+      : work_(work), num_chunks_(num_chunks) {}
+
+  void Retain() { ref_count_.fetch_add(1); }
+  void Release() {
+    if (ref_count_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+  // Claims and copies chunks until none are left.
+  void CopyChunks() {
+    intptr_t copied = 0;
+    while (true) {
+      const intptr_t chunk = next_chunk_.fetch_add(1);
+      if (chunk >= num_chunks_) break;
+      work_->CopyChunk(chunk);
+      copied++;
+    }
+    if (copied > 0) {
+      MonitorLocker ml(&monitor_);
+      copied_chunks_ += copied;
+      if (copied_chunks_ == num_chunks_) {
+        ml.Notify();
+      }
+    }
+  }
+
+  void WaitForChunks() {
+    MonitorLocker ml(&monitor_);
+    while (copied_chunks_ < num_chunks_) {
+      ml.Wait();
+    }
+  }
+
+ private:
+  // Helpers which start after all chunks were claimed must not use [work_],
+  // which only lives until [ParallelCopyWork::Run] returns.
+  ParallelCopyWork* const work_;
+  const intptr_t num_chunks_;
+  std::atomic<intptr_t> next_chunk_ = {0};
+  std::atomic<intptr_t> ref_count_ = {1};
+  Monitor monitor_;
+  intptr_t copied_chunks_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelCopyState);
+};
+
+class ParallelCopyTask : public ThreadPool::Task {
+ public:
+  explicit ParallelCopyTask(ParallelCopyState* state) : state_(state) {}
+
+  void Run() override {
+    state_->CopyChunks();
+    state_->Release();
+  }
+
+ private:
+  ParallelCopyState* state_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelCopyTask);
+};
+
+void ParallelCopyWork::Run(ParallelCopyWork* work, intptr_t num_chunks) {
+  auto state = new ParallelCopyState(work, num_chunks);
+  const intptr_t helpers =
+      Utils::Minimum<intptr_t>(FLAG_object_copy_helper_threads, num_chunks - 1);
+  for (intptr_t i = 0; i < helpers; i++) {
+    state->Retain();
+    if (!Dart::thread_pool()->Run<ParallelCopyTask>(state)) {
+      state->Release();
+      break;
+    }
+  }
+  // The current thread copies any chunks the helpers do not get to.
+  state->CopyChunks();
+  state->WaitForChunks();
+  state->Release();
+}
+
+// Large arrays and typed data are copied in rounds of one chunk per thread.
+constexpr intptr_t kParallelCopyChunkBytes = 1 * MB;
+constexpr intptr_t kParallelCopyChunkSlots = 64 * KB;
+
+static bool ShouldCopyInParallel(intptr_t chunks) {
+  return FLAG_object_copy_helper_threads > 0 && chunks > 1;
+}
+
+class CopyBytesWork : public ParallelCopyWork {
+ public:
+  CopyBytesWork(uint8_t* to, const uint8_t* from, intptr_t length)
+      : to_(to), from_(from), length_(length) {}
+
+  void CopyChunk(intptr_t chunk) override {
+    const intptr_t start = chunk * kParallelCopyChunkBytes;
+    memmove(to_ + start, from_ + start,
+            Utils::Minimum(kParallelCopyChunkBytes, length_ - start));
+  }
+
+ private:
+  uint8_t* const to_;
+  const uint8_t* const from_;
+  const intptr_t length_;
+};
+
 template <typename T>
 void CopyTypedDataBaseWithSafepointChecks(Thread* thread,
                                           const T& from,
                                           const T& to,
                                           intptr_t length) {
+  if (ShouldCopyInParallel(length / kParallelCopyChunkBytes)) {
+    const intptr_t round_size =
+        kParallelCopyChunkBytes * (FLAG_object_copy_helper_threads + 1);
+    for (intptr_t offset = 0; offset < length; offset += round_size) {
+      const intptr_t size = Utils::Minimum(round_size, length - offset);
+      {
+        NoSafepointScope no_safepoint_scope(thread);
+        CopyBytesWork work(to.ptr().untag()->data_ + offset,
+                           from.ptr().untag()->data_ + offset, size);
+        ParallelCopyWork::Run(&work, (size + kParallelCopyChunkBytes - 1) /
+                                         kParallelCopyChunkBytes);
+      }
+      thread->CheckForSafepoint();
+    }
+    return;
+  }
+
   constexpr intptr_t kChunkSize = 100 * 1024;
 
   const intptr_t chunks = length / kChunkSize;
@@ -629,7 +784,8 @@ class FastForwardMap : public ForwardMapBase {
         raw_from_to_(thread->zone(), 20),
         raw_transferables_from_to_(thread->zone(), 0),
         raw_objects_to_rehash_(thread->zone(), 0),
-        raw_expandos_to_rehash_(thread->zone(), 0) {
+        raw_expandos_to_rehash_(thread->zone(), 0),
+        raw_maps_to_check_(thread->zone(), 0) {
     raw_from_to_.Resize(2);
     raw_from_to_[0] = Object::null();
     raw_from_to_[1] = Object::null();
@@ -661,6 +817,7 @@ class FastForwardMap : public ForwardMapBase {
 
   void AddObjectToRehash(ObjectPtr to) { raw_objects_to_rehash_.Add(to); }
   void AddExpandoToRehash(ObjectPtr to) { raw_expandos_to_rehash_.Add(to); }
+  void AddMapToCheck(ObjectPtr to) { raw_maps_to_check_.Add(to); }
 
  private:
   friend class FastObjectCopy;
@@ -672,6 +829,7 @@ class FastForwardMap : public ForwardMapBase {
   GrowableArray<ExternalTypedDataPtr> raw_external_typed_data_to_;
   GrowableArray<ObjectPtr> raw_objects_to_rehash_;
   GrowableArray<ObjectPtr> raw_expandos_to_rehash_;
+  GrowableArray<ObjectPtr> raw_maps_to_check_;
   GrowableArray<WeakPropertyPtr> raw_weak_properties_;
   GrowableArray<WeakReferencePtr> raw_weak_references_;
   intptr_t fill_cursor_ = 0;
@@ -728,6 +886,9 @@ class SlowForwardMap : public ForwardMapBase {
   void AddExpandoToRehash(const Object& to) {
     expandos_to_rehash_.Add(&Object::Handle(to.ptr()));
   }
+  void AddMapToCheck(const Object& to) {
+    maps_to_check_.Add(&Object::Handle(to.ptr()));
+  }
 
   void FinalizeTransferables() {
     for (intptr_t i = 0; i < transferables_from_to_.length(); i += 2) {
@@ -756,6 +917,7 @@ class SlowForwardMap : public ForwardMapBase {
   GrowableArray<const ExternalTypedData*> external_typed_data_;
   GrowableArray<const Object*> objects_to_rehash_;
   GrowableArray<const Object*> expandos_to_rehash_;
+  GrowableArray<const Object*> maps_to_check_;
   GrowableArray<const WeakProperty*> weak_properties_;
   GrowableArray<const WeakReference*> weak_references_;
   intptr_t fill_cursor_ = 0;
@@ -777,6 +939,11 @@ class ObjectCopyBase {
         to_(Object::Handle(thread->zone())),
         expando_cid_(Class::GetClassId(
             thread->isolate_group()->object_store()->expando_class())),
+#if defined(HASH_IN_OBJECT_HEADER)
+        preserve_hashes_(FLAG_preserve_hashes_in_object_copy),
+#else
+        preserve_hashes_(false),
+#endif
         exception_unexpected_object_(Object::Handle(thread->zone())) {}
   ~ObjectCopyBase() {}
 
@@ -839,6 +1006,18 @@ class ObjectCopyBase {
         reinterpret_cast<uint8_t*>(obj.untag()) + offset) = value;
   }
 
+  DART_FORCE_INLINE
+  void CopyIdentityHash(ObjectPtr from, ObjectPtr to) {
+#if defined(HASH_IN_OBJECT_HEADER)
+    if (preserve_hashes_) {
+      const uint32_t hash = Object::GetCachedHash(from);
+      if (hash != 0) {
+        Object::SetCachedHashIfNotSet(to, hash);
+      }
+    }
+#endif
+  }
+
   DART_FORCE_INLINE
   bool CanCopyObject(uword tags, ObjectPtr object) {
     const auto cid = UntaggedObject::ClassIdTag::decode(tags);
@@ -890,6 +1069,10 @@ class ObjectCopyBase {
   Object& tmp_;
   Object& to_;
   intptr_t expando_cid_;
+  // Whether copies get the identity hash codes of the originals, so maps and
+  // sets keyed by them only need rehashing if the keys' classes override
+  // `hashCode`.
+  const bool preserve_hashes_;
 
   const char* exception_msg_ = nullptr;
   Object& exception_unexpected_object_;
@@ -1432,6 +1615,7 @@ class FastObjectCopyBase : public ObjectCopyBase {
   void EnqueueExpandoToRehash(ObjectPtr to) {
     fast_forward_map_.AddExpandoToRehash(to);
   }
+  void EnqueueMapToCheck(ObjectPtr to) { fast_forward_map_.AddMapToCheck(to); }
 
   static void StoreCompressedArrayPointers(intptr_t array_length,
                                            ObjectPtr src,
@@ -1503,6 +1687,11 @@ class SlowObjectCopyBase : public ObjectCopyBase {
                                       intptr_t offset,
                                       intptr_t end_offset) {
     if (Array::UseCardMarkingForAllocation(array_length)) {
+      if (ShouldCopyInParallel(array_length / kParallelCopyChunkSlots)) {
+        ForwardCompressedLargeArrayPointersInParallel(src, dst, offset,
+                                                      end_offset);
+        return;
+      }
       for (; offset < end_offset; offset += kCompressedWordSize) {
         ForwardCompressedLargeArrayPointer(src, dst, offset);
         thread_->CheckForSafepoint();
@@ -1524,6 +1713,102 @@ class SlowObjectCopyBase : public ObjectCopyBase {
     }
   }
 
+  // Stores the elements of a chunk of a large array which are shared rather
+  // than copied, and records which elements need forwarding.
+  class ShareArrayElementsWork : public ParallelCopyWork {
+   public:
+    ShareArrayElementsWork(uword heap_base,
+                           ObjectPtr src,
+                           ObjectPtr dst,
+                           intptr_t offset,
+                           intptr_t end_offset,
+                           bool* needs_forwarding)
+        : heap_base_(heap_base),
+          src_(src),
+          dst_(dst),
+          offset_(offset),
+          end_offset_(end_offset),
+          needs_forwarding_(needs_forwarding) {}
+
+    void CopyChunk(intptr_t chunk) override {
+      const intptr_t chunk_size = kParallelCopyChunkSlots * kCompressedWordSize;
+      const intptr_t start = offset_ + chunk * chunk_size;
+      const intptr_t end = Utils::Minimum(end_offset_, start + chunk_size);
+      bool* needs_forwarding =
+          needs_forwarding_ + ((start - offset_) >> kCompressedWordSizeLog2);
+      for (intptr_t offset = start; offset < end;
+           offset += kCompressedWordSize) {
+        auto value = LoadCompressedPointer(src_, offset);
+        if (value.IsHeapObject()) {
+          auto value_decompressed = value.Decompress(heap_base_);
+          const uword tags = TagsFromUntaggedObject(value_decompressed.untag());
+          if (!CanShareObject(value_decompressed, tags)) {
+            *needs_forwarding++ = true;
+            continue;
+          }
+          if (value_decompressed->IsNewObject()) {
+            // Generational barrier. The incremental barrier is not needed
+            // since we only get here when not marking.
+            Page::Of(dst_)->RememberCard(
+                reinterpret_cast<CompressedObjectPtr*>(
+                    reinterpret_cast<uword>(dst_.untag()) + offset));
+          }
+        }
+        StoreCompressedPointerNoBarrier(dst_, offset, value);
+        *needs_forwarding++ = false;
+      }
+    }
+
+   private:
+    const uword heap_base_;
+    const ObjectPtr src_;
+    const ObjectPtr dst_;
+    const intptr_t offset_;
+    const intptr_t end_offset_;
+    bool* const needs_forwarding_;
+  };
+
+  // Stores the shared elements of a large array on helper threads in rounds,
+  // after each of which the elements which need forwarding are forwarded
+  // here.
+  void ForwardCompressedLargeArrayPointersInParallel(const Object& src,
+                                                     const Object& dst,
+                                                     intptr_t offset,
+                                                     intptr_t end_offset) {
+    ASSERT(dst.ptr()->IsOldObject() && dst.ptr()->untag()->IsCardRemembered());
+    const intptr_t chunk_size = kParallelCopyChunkSlots * kCompressedWordSize;
+    const intptr_t round_size =
+        chunk_size * (FLAG_object_copy_helper_threads + 1);
+    std::unique_ptr<bool[]> needs_forwarding(
+        new bool[round_size >> kCompressedWordSizeLog2]);
+    while (offset < end_offset) {
+      const intptr_t round_end =
+          Utils::Minimum(end_offset, offset + round_size);
+      if (thread_->is_marking()) {
+        // Helpers cannot add to the marking stack.
+        for (; offset < round_end; offset += kCompressedWordSize) {
+          ForwardCompressedLargeArrayPointer(src, dst, offset);
+          thread_->CheckForSafepoint();
+        }
+        continue;
+      }
+      {
+        NoSafepointScope no_safepoint_scope(thread_);
+        ShareArrayElementsWork work(heap_base_, src.ptr(), dst.ptr(), offset,
+                                    round_end, needs_forwarding.get());
+        ParallelCopyWork::Run(
+            &work, (round_end - offset + chunk_size - 1) / chunk_size);
+      }
+      for (intptr_t i = 0; offset < round_end;
+           offset += kCompressedWordSize, i++) {
+        if (needs_forwarding[i]) {
+          ForwardCompressedLargeArrayPointer(src, dst, offset);
+        }
+        thread_->CheckForSafepoint();
+      }
+    }
+  }
+
   DART_FORCE_INLINE
   void ForwardCompressedLargeArrayPointer(const Object& src,
                                           const Object& dst,
@@ -1639,6 +1924,9 @@ class SlowObjectCopyBase : public ObjectCopyBase {
   void EnqueueExpandoToRehash(const Object& to) {
     slow_forward_map_.AddExpandoToRehash(to);
   }
+  void EnqueueMapToCheck(const Object& to) {
+    slow_forward_map_.AddMapToCheck(to);
+  }
 
   void StoreCompressedArrayPointers(intptr_t array_length,
                                     const Object& src,
@@ -1871,6 +2159,14 @@ class ObjectCopy : public Base {
       }
     }
 
+    // If copies keep the identity hash codes of the originals, we keep the
+    // index and decide once the whole graph is copied whether any key might
+    // compute a different hash code.
+    const bool check_keys = needs_rehashing && Base::preserve_hashes_;
+    if (check_keys) {
+      needs_rehashing = false;
+    }
+
     Base::StoreCompressedPointers(
         from, to, OFFSET_OF(UntaggedLinkedHashBase, type_arguments_),
         OFFSET_OF(UntaggedLinkedHashBase, type_arguments_));
@@ -1912,6 +2208,9 @@ class ObjectCopy : public Base {
     if (Base::exception_msg_ == nullptr && needs_rehashing) {
       Base::EnqueueObjectToRehash(to);
     }
+    if (Base::exception_msg_ == nullptr && check_keys) {
+      Base::EnqueueMapToCheck(to);
+    }
   }
 
   void CopyMap(typename Types::Map from, typename Types::Map to) {
@@ -2272,6 +2571,7 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase> {
                                   from.untag()->HeapSize() - kWordSize) =
         nullptr;
     SetNewSpaceTaggingWord(to, cid, size);
+    CopyIdentityHash(from, to);
 
     // Fall back to virtual variant for predefined classes
     if (cid < kNumPredefinedCids && cid != kInstanceCid) {
@@ -2402,6 +2702,7 @@ class SlowObjectCopy : public ObjectCopy<SlowObjectCopyBase> {
 
   void CopyObject(const Object& from, const Object& to) {
     const auto cid = from.GetClassId();
+    CopyIdentityHash(from.ptr(), to.ptr());
 
     // Fall back to virtual variant for predefined classes
     if (cid < kNumPredefinedCids && cid != kInstanceCid) {
@@ -2443,6 +2744,9 @@ class ObjectGraphCopier : public StackResource {
       LongJumpScope jump(thread_);  // e.g. for OOMs.
       if (DART_SETJMP(*jump.Set()) == 0) {
         result = CopyObjectGraphInternal(root, &exception_msg);
+        if (exception_msg == nullptr) {
+          RehashMapsWithChangingKeys(Array::Cast(result));
+        }
         // Any allocated external typed data must have finalizers attached so
         // memory will get free()ed.
         slow_object_copy_.slow_forward_map_.FinalizeExternalTypedData();
@@ -2528,6 +2832,7 @@ class ObjectGraphCopier : public StackResource {
             result_array.SetAt(2, fast_object_copy_.tmp_);
             HandlifyExternalTypedData();
             HandlifyTransferables();
+            HandlifyMapsToCheck();
             allocated_bytes_ =
                 fast_object_copy_.fast_forward_map_.allocated_bytes;
             copied_objects_ =
@@ -2595,6 +2900,7 @@ class ObjectGraphCopier : public StackResource {
     HandlifyExternalTypedData();
     HandlifyObjectsToReHash();
     HandlifyExpandosToReHash();
+    HandlifyMapsToCheck();
     HandlifyFromToObjects();
     slow_forward_map.fill_cursor_ = fast_forward_map.fill_cursor_;
     slow_forward_map.allocated_bytes = fast_forward_map.allocated_bytes;
@@ -2667,6 +2973,10 @@ class ObjectGraphCopier : public StackResource {
     Handlify(&fast_object_copy_.fast_forward_map_.raw_expandos_to_rehash_,
              &slow_object_copy_.slow_forward_map_.expandos_to_rehash_);
   }
+  void HandlifyMapsToCheck() {
+    Handlify(&fast_object_copy_.fast_forward_map_.raw_maps_to_check_,
+             &slow_object_copy_.slow_forward_map_.maps_to_check_);
+  }
   template <typename PtrType, typename HandleType>
   void Handlify(GrowableArray<PtrType>* from,
                 GrowableArray<const HandleType*>* to) {
@@ -2704,6 +3014,101 @@ class ObjectGraphCopier : public StackResource {
     from_to_transition.Clear();
   }
 
+  // Copied maps and sets whose keys keep their identity hash codes keep their
+  // index, unless a key might compute a different hash code in the receiver
+  // (e.g. due to a user-defined `hashCode`). Those are added to the objects
+  // to rehash in [result_array].
+  void RehashMapsWithChangingKeys(const Array& result_array) {
+    const auto& maps_to_check =
+        slow_object_copy_.slow_forward_map_.maps_to_check_;
+    if (maps_to_check.is_empty()) return;
+
+    GrowableArray<const Object*> maps_to_rehash;
+    auto& data = Array::Handle(zone_);
+    auto& key = Object::Handle(zone_);
+    for (intptr_t i = 0; i < maps_to_check.length(); i++) {
+      const auto& map = *maps_to_check[i];
+      data = LinkedHashBase::Cast(map).data();
+      const intptr_t used_data =
+          Smi::Value(LinkedHashBase::Cast(map).used_data());
+      const intptr_t step = map.IsMap() ? 2 : 1;
+      bool keys_keep_hash_codes = true;
+      for (intptr_t j = 0; j < used_data && keys_keep_hash_codes; j += step) {
+        key = data.At(j);
+        // Deleted entries refer to the data array.
+        if (key.ptr() != data.ptr()) {
+          keys_keep_hash_codes = KeepsHashCode(key);
+        }
+        thread_->CheckForSafepoint();
+      }
+      if (!keys_keep_hash_codes) {
+        auto untagged_map = static_cast<LinkedHashBasePtr>(map.ptr()).untag();
+        untagged_map->set_hash_mask(Smi::New(0));
+        untagged_map->set_index(TypedData::RawCast(Object::null()));
+        untagged_map->set_deleted_keys(Smi::New(0));
+        maps_to_rehash.Add(&map);
+      }
+    }
+    if (maps_to_rehash.is_empty()) return;
+
+    const auto& objects_to_rehash =
+        Array::Handle(zone_, Array::RawCast(result_array.At(1)));
+    const intptr_t length =
+        objects_to_rehash.IsNull() ? 0 : objects_to_rehash.Length();
+    const auto& array = Array::Handle(
+        zone_, Array::New(length + maps_to_rehash.length()));
+    for (intptr_t i = 0; i < length; i++) {
+      key = objects_to_rehash.At(i);
+      array.SetAt(i, key);
+    }
+    for (intptr_t i = 0; i < maps_to_rehash.length(); i++) {
+      array.SetAt(length + i, *maps_to_rehash[i]);
+    }
+    result_array.SetAt(1, array);
+  }
+
+  bool KeepsHashCode(const Object& key) {
+    if (!key.ptr()->IsHeapObject() || !MightNeedReHashing(key.ptr())) {
+      return true;
+    }
+    const intptr_t cid = key.GetClassId();
+    if (identity_hashed_cids_ == nullptr) {
+      num_cids_ = thread_->isolate_group()->class_table()->NumCids();
+      identity_hashed_cids_ = zone_->Alloc<int8_t>(num_cids_);
+      memset(identity_hashed_cids_, kUnknownHashCode, num_cids_);
+    }
+    ASSERT(cid < num_cids_);
+    if (identity_hashed_cids_[cid] == kUnknownHashCode) {
+      identity_hashed_cids_[cid] =
+          UsesIdentityHashCode(cid) ? kIdentityHashCode : kOtherHashCode;
+    }
+    return identity_hashed_cids_[cid] == kIdentityHashCode;
+  }
+
+  // Whether instances of the class use the `hashCode` of `Object`.
+  bool UsesIdentityHashCode(intptr_t cid) {
+    auto isolate_group = thread_->isolate_group();
+    const auto& object_class =
+        Class::Handle(zone_, isolate_group->object_store()->object_class());
+    auto& cls = Class::Handle(zone_, isolate_group->class_table()->At(cid));
+    for (; !cls.IsNull() && cls.ptr() != object_class.ptr();
+         cls = cls.SuperClass()) {
+      if (cls.LookupInstanceField(Symbols::HashCode()) != Field::null()) {
+        return false;
+      }
+    }
+    cls = isolate_group->class_table()->At(cid);
+    SafepointReadRwLocker ml(thread_, isolate_group->program_lock());
+    for (; !cls.IsNull() && cls.ptr() != object_class.ptr();
+         cls = cls.SuperClass()) {
+      if (cls.LookupDynamicFunctionUnsafe(Symbols::GetHashCode()) !=
+          Function::null()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void ThrowException(const char* exception_msg) {
     const auto& msg_obj = String::Handle(Z, String::New(exception_msg));
     const auto& args = Array::Handle(Z, Array::New(1));
@@ -2719,6 +3124,12 @@ class ObjectGraphCopier : public StackResource {
   SlowObjectCopy slow_object_copy_;
   intptr_t copied_objects_ = 0;
   intptr_t allocated_bytes_ = 0;
+
+  static constexpr int8_t kUnknownHashCode = 0;
+  static constexpr int8_t kIdentityHashCode = 1;
+  static constexpr int8_t kOtherHashCode = 2;
+  int8_t* identity_hashed_cids_ = nullptr;
+  intptr_t num_cids_ = 0;
 };
 
 ObjectPtr CopyMutableObjectGraph(const Object& object) {
@@ -9,6 +9,7 @@
 #include "vm/object.h"
 #include "vm/object_graph.h"
 #include "vm/object_store.h"
+#include "vm/port.h"
 #include "vm/resolver.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
@@ -1893,6 +1894,11 @@ void ReceivePort::PrintJSONImpl(JSONStream* stream, bool ref) const {
   obj.AddProperty64("portId", Id());
   obj.AddProperty("debugName", debug_name_.ToCString());
   obj.AddProperty("allocationLocation", allocation_location_);
+  intptr_t capacity = 0;
+  obj.AddProperty("_queueDepth", PortMap::GetQueueDepth(Id(), &capacity));
+  if (capacity > 0) {
+    obj.AddProperty("_capacity", capacity);
+  }
 }
 
 void ReceivePort::PrintImplementationFieldsImpl(
@@ -10,6 +10,7 @@
 #include "platform/utils.h"
 #include "vm/dart_api_impl.h"
 #include "vm/dart_entry.h"
+#include "vm/growable_array.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
 #include "vm/message_handler.h"
@@ -17,10 +18,194 @@
 
 namespace dart {
 
+// An open addressing table from port ids to handlers which readers probe
+// without taking [PortMap::mutex_]. It is only modified with the mutex held.
+//
+// Slots only ever go from free to used to deleted, so a reader never sees a
+// slot reused for another port. Deleted slots are dropped by copying the
+// live entries to a new table, which replaces this one once no reader can
+// still be using it.
+class PortMap::HandlerTable : public MallocAllocated {
+ public:
+  static constexpr intptr_t kInitialCapacity = 64;
+
+  explicit HandlerTable(intptr_t capacity)
+      : capacity_(capacity), slots_(new Slot[capacity]) {
+    ASSERT(Utils::IsPowerOfTwo(capacity));
+  }
+  ~HandlerTable() { delete[] slots_; }
+
+  PortHandler* Lookup(Dart_Port port, Bound** bound) const {
+    if (port == PortSet<Entry>::kFreePort ||
+        port == PortSet<Entry>::kDeletedPort) {
+      return nullptr;
+    }
+    // The table is never more than half full, so this finds a free slot.
+    for (intptr_t i = IndexOf(port);; i = (i + 1) & (capacity_ - 1)) {
+      // Pairs with the release store in [Insert].
+      const Dart_Port current = slots_[i].port.load(std::memory_order_acquire);
+      if (current == port) {
+        if (bound != nullptr) {
+          *bound = slots_[i].bound.load(std::memory_order_relaxed);
+        }
+        return slots_[i].handler.load(std::memory_order_relaxed);
+      }
+      if (current == PortSet<Entry>::kFreePort) {
+        return nullptr;
+      }
+    }
+  }
+
+  // Returns false if the table has to be replaced by a larger one first.
+  bool Insert(Dart_Port port, PortHandler* handler, Bound* bound) {
+    if (2 * (used_ + deleted_ + 1) > capacity_) {
+      return false;
+    }
+    intptr_t i = IndexOf(port);
+    while (slots_[i].port.load(std::memory_order_relaxed) !=
+           PortSet<Entry>::kFreePort) {
+      i = (i + 1) & (capacity_ - 1);
+    }
+    slots_[i].handler.store(handler, std::memory_order_relaxed);
+    slots_[i].bound.store(bound, std::memory_order_relaxed);
+    slots_[i].port.store(port, std::memory_order_release);
+    used_++;
+    return true;
+  }
+
+  void Remove(Dart_Port port) {
+    for (intptr_t i = IndexOf(port);; i = (i + 1) & (capacity_ - 1)) {
+      const Dart_Port current = slots_[i].port.load(std::memory_order_relaxed);
+      ASSERT(current != PortSet<Entry>::kFreePort);
+      if (current == port) {
+        slots_[i].port.store(PortSet<Entry>::kDeletedPort,
+                             std::memory_order_relaxed);
+        used_--;
+        deleted_++;
+        return;
+      }
+    }
+  }
+
+  // Returns a table with the live entries of this one and room for at least
+  // one more.
+  HandlerTable* CopyLive() const {
+    intptr_t capacity = kInitialCapacity;
+    while (capacity < 4 * (used_ + 1)) {
+      capacity *= 2;
+    }
+    HandlerTable* table = new HandlerTable(capacity);
+    for (intptr_t i = 0; i < capacity_; i++) {
+      const Dart_Port port = slots_[i].port.load(std::memory_order_relaxed);
+      if (port != PortSet<Entry>::kFreePort &&
+          port != PortSet<Entry>::kDeletedPort) {
+        const bool inserted = table->Insert(
+            port, slots_[i].handler.load(std::memory_order_relaxed),
+            slots_[i].bound.load(std::memory_order_relaxed));
+        ASSERT(inserted);
+      }
+    }
+    return table;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<Dart_Port> port = {PortSet<Entry>::kFreePort};
+    std::atomic<PortHandler*> handler = {nullptr};
+    std::atomic<Bound*> bound = {nullptr};
+  };
+
+  intptr_t IndexOf(Dart_Port port) const {
+    // The two lowest bits are set in all port ids.
+    return static_cast<intptr_t>(port >> 2) & (capacity_ - 1);
+  }
+
+  const intptr_t capacity_;
+  Slot* const slots_;
+  intptr_t used_ = 0;
+  intptr_t deleted_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HandlerTable);
+};
+
+// Marks the current thread as possibly using handlers found in
+// [PortMap::handlers_].
+//
+// Readers count themselves in one of two sets of counters, picked by the
+// parity of [epoch_], and spread over several cache lines by thread.
+// [WaitForReadersLocked] flips the parity and waits for the previous set to
+// drain. A reader whose increment it does not see reads the new epoch when
+// it checks again and retries. Since the port was removed before the flip,
+// the retried lookup cannot find it anymore.
+class PortMap::ReadSection : public ValueObject {
+ public:
+  ReadSection() {
+    const intptr_t stripe =
+        Utils::WordHash(OSThread::ThreadIdToIntPtr(
+            OSThread::GetCurrentThreadId())) &
+        (kStripes - 1);
+    while (true) {
+      const uintptr_t epoch = epoch_.load(std::memory_order_seq_cst);
+      count_ = &readers_[epoch & 1][stripe].count;
+      count_->fetch_add(1, std::memory_order_seq_cst);
+      if (epoch_.load(std::memory_order_seq_cst) == epoch) break;
+      count_->fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+  ~ReadSection() { count_->fetch_sub(1, std::memory_order_release); }
+
+  static void WaitForReaders() {
+    const uintptr_t previous =
+        epoch_.fetch_add(1, std::memory_order_seq_cst) & 1;
+    for (intptr_t i = 0; i < kStripes; i++) {
+      std::atomic<intptr_t>* count = &readers_[previous][i].count;
+      for (intptr_t spins = 0;
+           count->load(std::memory_order_seq_cst) != 0; spins++) {
+        // Readers only post a message, so they are usually done after a few
+        // spins.
+        if (spins > 100) {
+          OS::SleepMicros(1);
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr intptr_t kStripes = 16;
+
+  struct alignas(64) ReaderCount {
+    std::atomic<intptr_t> count = {0};
+  };
+
+  static std::atomic<uintptr_t> epoch_;
+  static ReaderCount readers_[2][kStripes];
+
+  std::atomic<intptr_t>* count_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadSection);
+};
+
+std::atomic<uintptr_t> PortMap::ReadSection::epoch_ = {0};
+PortMap::ReadSection::ReaderCount PortMap::ReadSection::readers_[2][kStripes];
+
 Mutex* PortMap::mutex_ = nullptr;
 PortSet<PortMap::Entry>* PortMap::ports_ = nullptr;
+std::atomic<PortMap::HandlerTable*> PortMap::handlers_ = {nullptr};
 Random* PortMap::prng_ = nullptr;
 
+PortHandler* PortMap::LookupHandler(Dart_Port id, Bound** bound) {
+  HandlerTable* handlers = handlers_.load(std::memory_order_acquire);
+  if (handlers == nullptr) {
+    return nullptr;
+  }
+  return handlers->Lookup(id, bound);
+}
+
+void PortMap::WaitForReadersLocked(const Locker& ml) {
+  ASSERT(mutex_->IsOwnedByCurrentThread());
+  ReadSection::WaitForReaders();
+}
+
 Dart_Port PortMap::AllocatePort() {
   Dart_Port result;
 
@@ -52,8 +237,11 @@ Dart_Port PortMap::AllocatePort() {
   return result;
 }
 
-Dart_Port PortMap::CreatePort(PortHandler* handler) {
+Dart_Port PortMap::CreatePort(PortHandler* handler,
+                              intptr_t capacity,
+                              bool block_senders) {
   ASSERT(handler != nullptr);
+  ASSERT(capacity >= 0);
   PortMap::Locker ml;
   if (ports_ == nullptr) {
     return ILLEGAL_PORT;
@@ -63,7 +251,17 @@ Dart_Port PortMap::CreatePort(PortHandler* handler) {
   if (auto ports = handler->ports(ml)) {
     ports->Insert(PortHandler::PortSetEntry{port});
   }
-  ports_->Insert(Entry{port, handler});
+  Bound* bound = capacity > 0 ? new Bound(capacity, block_senders) : nullptr;
+  ports_->Insert(Entry{port, handler, bound});
+  HandlerTable* handlers = handlers_.load(std::memory_order_relaxed);
+  if (!handlers->Insert(port, handler, bound)) {
+    HandlerTable* grown = handlers->CopyLive();
+    const bool inserted = grown->Insert(port, handler, bound);
+    ASSERT(inserted);
+    handlers_.store(grown, std::memory_order_release);
+    WaitForReadersLocked(ml);
+    delete handlers;
+  }
 
   if (FLAG_trace_isolates) {
     OS::PrintErr(
@@ -80,6 +278,7 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
   if (port_handler != nullptr) *port_handler = nullptr;
 
   PortHandler* handler = nullptr;
+  Bound* bound = nullptr;
   {
     PortMap::Locker ml;
     if (ports_ == nullptr) {
@@ -91,6 +290,7 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
     }
     Entry entry = *it;
     handler = entry.handler;
+    bound = entry.bound;
     ASSERT(handler != nullptr);
 
 #if defined(DEBUG)
@@ -99,6 +299,7 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
 
     it.Delete();
     ports_->Rebalance();
+    handlers_.load(std::memory_order_relaxed)->Remove(port);
 
     if (auto ports = handler->ports(ml)) {
       auto isolate_it = ports->TryLookup(port);
@@ -106,7 +307,12 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
       isolate_it.Delete();
       ports->Rebalance();
     }
+
+    // Messages posted concurrently reach the handler before it learns that
+    // the port is closed, as if they had been posted before.
+    WaitForReadersLocked(ml);
   }
+  delete bound;
   handler->OnPortClosed(port);
   if (port_handler != nullptr) *port_handler = handler;
   return true;
@@ -122,6 +328,8 @@ void PortMap::ClosePorts(MessageHandler* handler) {
     auto ports = handler->ports(ml);
     ASSERT(ports != nullptr);
 
+    HandlerTable* handlers = handlers_.load(std::memory_order_relaxed);
+    MallocGrowableArray<Bound*> bounds;
     for (auto isolate_it = ports->begin(); isolate_it != ports->end();
          ++isolate_it) {
       auto it = ports_->TryLookup((*isolate_it).port);
@@ -129,41 +337,103 @@ void PortMap::ClosePorts(MessageHandler* handler) {
       Entry entry = *it;
       ASSERT(entry.port == (*isolate_it).port);
       ASSERT(entry.handler == handler);
+      handlers->Remove(entry.port);
+      if (entry.bound != nullptr) {
+        bounds.Add(entry.bound);
+      }
       it.Delete();
       isolate_it.Delete();
     }
     ASSERT(ports->IsEmpty());
     ports_->Rebalance();
+    WaitForReadersLocked(ml);
+    for (intptr_t i = 0; i < bounds.length(); i++) {
+      delete bounds[i];
+    }
   }
   handler->OnAllPortsClosed();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
                           bool before_events) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  ReadSection reader;
+  if (handlers_.load(std::memory_order_relaxed) == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
+  Bound* bound = nullptr;
+  PortHandler* handler = LookupHandler(message->dest_port(), &bound);
+  if (handler == nullptr) {
     // Ownership of external data remains with the poster.
     message->DropFinalizers();
     return false;
   }
-  auto handler = (*it).handler;
-  ASSERT(handler != nullptr);
+  if (bound != nullptr) {
+    bound->queued.fetch_add(1, std::memory_order_relaxed);
+    message->set_counted_by_port();
+  }
   handler->PostMessage(std::move(message), before_events);
   return true;
 }
 
+PortMap::PostResult PortMap::TryPostMessage(
+    std::unique_ptr<Message>* message) {
+  ReadSection reader;
+  if (handlers_.load(std::memory_order_relaxed) == nullptr) {
+    message->reset();
+    return PostResult::kClosed;
+  }
+  Bound* bound = nullptr;
+  PortHandler* handler = LookupHandler((*message)->dest_port(), &bound);
+  if (handler == nullptr) {
+    // Ownership of external data remains with the poster.
+    (*message)->DropFinalizers();
+    message->reset();
+    return PostResult::kClosed;
+  }
+  if (bound != nullptr) {
+    intptr_t queued = bound->queued.load(std::memory_order_relaxed);
+    do {
+      if (queued >= bound->capacity) {
+        return bound->block_senders ? PostResult::kBusy : PostResult::kFull;
+      }
+    } while (!bound->queued.compare_exchange_weak(queued, queued + 1,
+                                                  std::memory_order_relaxed));
+    (*message)->set_counted_by_port();
+  }
+  handler->PostMessage(std::move(*message));
+  return PostResult::kPosted;
+}
+
+void PortMap::OnMessageDequeued(const Message& message) {
+  ASSERT(message.counted_by_port());
+  ReadSection reader;
+  Bound* bound = nullptr;
+  if (LookupHandler(message.dest_port(), &bound) != nullptr &&
+      bound != nullptr) {
+    bound->queued.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+intptr_t PortMap::GetQueueDepth(Dart_Port id, intptr_t* capacity) {
+  *capacity = 0;
+  ReadSection reader;
+  Bound* bound = nullptr;
+  PortHandler* handler = LookupHandler(id, &bound);
+  if (handler == nullptr) {
+    return 0;
+  }
+  if (bound != nullptr) {
+    *capacity = bound->capacity;
+    return Utils::Maximum<intptr_t>(
+        0, bound->queued.load(std::memory_order_relaxed));
+  }
+  return handler->QueuedMessages(id);
+}
+
 #if defined(TESTING)
 bool PortMap::PortExists(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
-    return false;
-  }
-  auto it = ports_->TryLookup(id);
-  return it != ports_->end();
+  ReadSection reader;
+  return LookupHandler(id) != nullptr;
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
@@ -187,17 +457,13 @@ Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
 }
 
 Dart_Port PortMap::GetOriginId(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
-    return ILLEGAL_PORT;
-  }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  ReadSection reader;
+  PortHandler* handler = LookupHandler(id);
+  if (handler == nullptr) {
     // Port does not exist.
     return ILLEGAL_PORT;
   }
 
-  auto handler = (*it).handler;
   Isolate* isolate = handler->isolate();
   if (isolate == nullptr) {
     // Message handler is a native port instead of an isolate.
@@ -230,17 +496,13 @@ bool PortMap::HasPorts(MessageHandler* handler) {
 
 bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
                                                    IsolateGroup* group) {
-  Locker ml;
-  if (ports_ == nullptr) {
-    // Port was closed.
-    return true;
-  }
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) {
+  ReadSection reader;
+  PortHandler* handler = LookupHandler(receiver);
+  if (handler == nullptr) {
     // Port was closed.
     return true;
   }
-  auto isolate = (*it).handler->isolate();
+  auto isolate = handler->isolate();
   if (isolate == nullptr) {
     // Port belongs to a native port instead of an isolate.
     return false;
@@ -258,6 +520,8 @@ void PortMap::Init() {
   }
   if (ports_ == nullptr) {
     ports_ = new PortSet<Entry>();
+    handlers_.store(new HandlerTable(HandlerTable::kInitialCapacity),
+                    std::memory_order_release);
   }
 }
 
@@ -275,6 +539,7 @@ void PortMap::Cleanup() {
     const auto& entry = *it;
     ASSERT(entry.handler != nullptr);
     delete entry.handler;
+    delete entry.bound;
     it.Delete();
   }
   ports_->Rebalance();
@@ -285,6 +550,10 @@ void PortMap::Cleanup() {
   prng_ = nullptr;
   delete ports_;
   ports_ = nullptr;
+  HandlerTable* handlers = handlers_.load(std::memory_order_relaxed);
+  handlers_.store(nullptr, std::memory_order_release);
+  WaitForReadersLocked(ml);
+  delete handlers;
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -306,6 +575,15 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
         port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
         msg_handler = DartLibraryCalls::LookupHandler(entry.port);
         port.AddProperty("handler", msg_handler);
+        if (entry.bound != nullptr) {
+          port.AddProperty("_capacity", entry.bound->capacity);
+          port.AddProperty(
+              "_queueDepth",
+              Utils::Maximum<intptr_t>(
+                  0, entry.bound->queued.load(std::memory_order_relaxed)));
+        } else {
+          port.AddProperty("_queueDepth", handler->QueuedMessages(entry.port));
+        }
       }
     }
   }
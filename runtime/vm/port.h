@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_PORT_H_
 #define RUNTIME_VM_PORT_H_
 
+#include <atomic>
 #include <memory>
 
 #include "include/dart_api.h"
@@ -26,7 +27,14 @@ class PortHandler;
 class PortMap : public AllStatic {
  public:
   // Allocate a port for the provided handler and return its VM-global id.
-  static Dart_Port CreatePort(PortHandler* handler);
+  //
+  // If [capacity] is positive, [TryPostMessage] does not let more than
+  // [capacity] messages to the port wait for the handler. Senders finding it
+  // full are asked to wait if [block_senders] is true, and are rejected
+  // otherwise.
+  static Dart_Port CreatePort(PortHandler* handler,
+                              intptr_t capacity = 0,
+                              bool block_senders = false);
 
   // Close the port with id. All pending messages will be dropped.
   //
@@ -39,10 +47,33 @@ class PortMap : public AllStatic {
   // Enqueues the message in the port with id. Returns false if the port is not
   // active any longer.
   //
+  // Does not take the port map lock, only the destination handler's.
+  //
   // Claims ownership of 'message'.
   static bool PostMessage(std::unique_ptr<Message> message,
                           bool before_events = false);
 
+  enum class PostResult {
+    kPosted,
+    // The port is closed. The message was dropped.
+    kClosed,
+    // The port is full and rejects senders.
+    kFull,
+    // The port is full and the sender should wait for it to have room.
+    kBusy,
+  };
+
+  // Like [PostMessage], but respects the capacity of bounded ports. Leaves
+  // the message with the caller if the port is full.
+  static PostResult TryPostMessage(std::unique_ptr<Message>* message);
+
+  // Called when the handler of a bounded port takes a message from its queue.
+  static void OnMessageDequeued(const Message& message);
+
+  // Returns the number of messages to the port with id which wait to be
+  // handled. Sets [capacity] to its capacity, or 0 if it is not bounded.
+  static intptr_t GetQueueDepth(Dart_Port id, intptr_t* capacity);
+
   // Returns the origin id for port 'id'.
   static Dart_Port GetOriginId(Dart_Port id);
 
@@ -75,24 +106,52 @@ class PortMap : public AllStatic {
   };
 
  private:
+  // The capacity of a bounded port and the messages counting towards it.
+  struct Bound : public MallocAllocated {
+    Bound(intptr_t capacity, bool block_senders)
+        : capacity(capacity), block_senders(block_senders) {}
+
+    const intptr_t capacity;
+    const bool block_senders;
+    // Messages posted to the port which its handler has not dequeued yet.
+    std::atomic<intptr_t> queued = {0};
+  };
+
   struct Entry : public PortSet<Entry>::Entry {
-    Entry() : handler(nullptr) {}
-    Entry(Dart_Port port, PortHandler* handler)
-        : PortSet<Entry>::Entry(port), handler(handler) {}
+    Entry() : handler(nullptr), bound(nullptr) {}
+    Entry(Dart_Port port, PortHandler* handler, Bound* bound)
+        : PortSet<Entry>::Entry(port), handler(handler), bound(bound) {}
 
     PortHandler* handler;
+    // Owned by the entry, or nullptr if the port is not bounded.
+    Bound* bound;
   };
 
+  class HandlerTable;
+  class ReadSection;
+
   // Allocate a new unique port.
   static Dart_Port AllocatePort();
 
   static Isolate* GetIsolateLocked(const Locker& ml, Dart_Port id);
 
+  // Returns the handler of the port with id, or nullptr, and sets [bound] to
+  // its bound if it has one. Must be called in a [ReadSection], which keeps
+  // both alive.
+  static PortHandler* LookupHandler(Dart_Port id, Bound** bound = nullptr);
+
+  // Waits until all [ReadSection]s which might have seen a port before it
+  // was removed from [handlers_] are done.
+  static void WaitForReadersLocked(const Locker& ml);
+
   // Lock protecting access to the port map.
   static Mutex* mutex_;
 
   static PortSet<Entry>* ports_;
 
+  // A copy of [ports_] which can be read without holding [mutex_].
+  static std::atomic<HandlerTable*> handlers_;
+
   static Random* prng_;
 };
 
@@ -121,6 +180,9 @@ class PortHandler {
   // Ask the handler to shutdown, e.g. stop associated thread pools if any.
   virtual void Shutdown() = 0;
 
+  // Returns the number of messages to [port] waiting in this handler's queue.
+  virtual intptr_t QueuedMessages(Dart_Port port) { return 0; }
+
   // Posts a message on this handler's message queue.
   // If before_events is true, then the message is enqueued before any pending
   // events, but after any pending isolate library events.
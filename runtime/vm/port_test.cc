@@ -131,4 +131,120 @@ TEST_CASE(PortMap_PostMessageClosedPort) {
                    message_len, nullptr, Message::kNormalPriority)));
 }
 
+TEST_CASE(PortMap_CreateManyOpenPorts) {
+  const intptr_t kPortCount = 1000;
+  PortTestMessageHandler handler;
+  Dart_Port ports[kPortCount];
+  for (intptr_t i = 0; i < kPortCount; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+  }
+  for (intptr_t i = 0; i < kPortCount; i += 2) {
+    PortMap::ClosePort(ports[i]);
+  }
+  for (intptr_t i = 0; i < kPortCount; i++) {
+    EXPECT_EQ(i % 2 != 0, PortMap::PortExists(ports[i]));
+  }
+  PortMap::ClosePorts(&handler);
+  for (intptr_t i = 0; i < kPortCount; i++) {
+    EXPECT(!PortMap::PortExists(ports[i]));
+  }
+}
+
+struct PostMessagesData {
+  Dart_Port port;
+  intptr_t count;
+  Monitor monitor;
+  bool done = false;
+};
+
+static void PostMessages(uword parameter) {
+  auto data = reinterpret_cast<PostMessagesData*>(parameter);
+  for (intptr_t i = 0; i < data->count; i++) {
+    EXPECT(PortMap::PostMessage(
+        Message::New(data->port, Smi::New(i), Message::kNormalPriority)));
+  }
+  MonitorLocker ml(&data->monitor);
+  data->done = true;
+  ml.Notify();
+}
+
+// Messages are posted without the port map lock, concurrently with ports
+// being opened and closed (and the lookup table being replaced).
+TEST_CASE(PortMap_PostMessageWhileClosingPorts) {
+  PortTestMessageHandler handler;
+  PostMessagesData data;
+  data.port = PortMap::CreatePort(&handler);
+  data.count = 10000;
+  OSThread::Start("PostMessages", PostMessages,
+                  reinterpret_cast<uword>(&data));
+
+  PortTestMessageHandler other_handler;
+  bool done = false;
+  while (!done) {
+    Dart_Port ports[100];
+    for (intptr_t i = 0; i < 100; i++) {
+      ports[i] = PortMap::CreatePort(&other_handler);
+    }
+    for (intptr_t i = 0; i < 100; i++) {
+      PortMap::ClosePort(ports[i]);
+    }
+    MonitorLocker ml(&data.monitor);
+    done = data.done;
+  }
+
+  EXPECT_EQ(data.count, handler.notify_count);
+  EXPECT_EQ(0, other_handler.notify_count);
+  PortMap::ClosePorts(&handler);
+}
+
+TEST_CASE(PortMap_BoundedPort) {
+  PortTestMessageHandler handler;
+  Dart_Port port = PortMap::CreatePort(&handler, /*capacity=*/2);
+  std::unique_ptr<Message> message;
+  for (intptr_t i = 0; i < 2; i++) {
+    message = Message::New(port, Smi::New(i), Message::kNormalPriority);
+    EXPECT(PortMap::TryPostMessage(&message) == PortMap::PostResult::kPosted);
+    EXPECT(message == nullptr);
+  }
+  message = Message::New(port, Smi::New(2), Message::kNormalPriority);
+  EXPECT(PortMap::TryPostMessage(&message) == PortMap::PostResult::kFull);
+  EXPECT(message != nullptr);
+
+  // Messages not sent with TryPostMessage are delivered anyway.
+  EXPECT(PortMap::PostMessage(std::move(message)));
+  intptr_t capacity = 0;
+  EXPECT_EQ(3, PortMap::GetQueueDepth(port, &capacity));
+  EXPECT_EQ(2, capacity);
+  EXPECT_EQ(3, handler.notify_count);
+
+  // Handling messages makes room for more.
+  EXPECT_EQ(MessageHandler::kOK, handler.HandleNextMessage());
+  EXPECT_EQ(MessageHandler::kOK, handler.HandleNextMessage());
+  EXPECT_EQ(1, PortMap::GetQueueDepth(port, &capacity));
+  message = Message::New(port, Smi::New(3), Message::kNormalPriority);
+  EXPECT(PortMap::TryPostMessage(&message) == PortMap::PostResult::kPosted);
+  EXPECT_EQ(2, PortMap::GetQueueDepth(port, &capacity));
+
+  // Senders to full ports which block are asked to retry.
+  Dart_Port blocking_port =
+      PortMap::CreatePort(&handler, /*capacity=*/1, /*block_senders=*/true);
+  message = Message::New(blocking_port, Smi::New(0), Message::kNormalPriority);
+  EXPECT(PortMap::TryPostMessage(&message) == PortMap::PostResult::kPosted);
+  message = Message::New(blocking_port, Smi::New(1), Message::kNormalPriority);
+  EXPECT(PortMap::TryPostMessage(&message) == PortMap::PostResult::kBusy);
+
+  // Unbounded ports count the messages in the queue.
+  Dart_Port unbounded_port = PortMap::CreatePort(&handler);
+  message =
+      Message::New(unbounded_port, Smi::New(0), Message::kNormalPriority);
+  EXPECT(PortMap::TryPostMessage(&message) == PortMap::PostResult::kPosted);
+  EXPECT_EQ(1, PortMap::GetQueueDepth(unbounded_port, &capacity));
+  EXPECT_EQ(0, capacity);
+
+  PortMap::ClosePorts(&handler);
+  message = Message::New(port, Smi::New(4), Message::kNormalPriority);
+  EXPECT(PortMap::TryPostMessage(&message) == PortMap::PostResult::kClosed);
+  EXPECT_EQ(0, PortMap::GetQueueDepth(port, &capacity));
+}
+
 }  // namespace dart
@@ -371,6 +371,15 @@ static Heap::Space SpaceForRuntimeAllocation() {
   return UNLIKELY(FLAG_runtime_allocate_old) ? Heap::kOld : Heap::kNew;
 }
 
+// Like the above, but also allocates instances of classes the scavenger has
+// chosen to pretenure directly in old-space.
+static Heap::Space SpaceForRuntimeAllocation(Thread* thread, intptr_t cid) {
+  if (UNLIKELY(thread->heap()->new_space()->ShouldPretenure(cid))) {
+    return Heap::kOld;
+  }
+  return SpaceForRuntimeAllocation();
+}
+
 static void RuntimeAllocationEpilogue(Thread* thread) {
   if (UNLIKELY(FLAG_runtime_allocate_spill_tlab)) {
     static RelaxedAtomic<uword> count = 0;
@@ -408,7 +417,8 @@ DEFINE_RUNTIME_ENTRY(AllocateArray, 2) {
 
   const Array& array = Array::Handle(
       zone,
-      Array::New(static_cast<intptr_t>(len), SpaceForRuntimeAllocation()));
+      Array::New(static_cast<intptr_t>(len),
+                 SpaceForRuntimeAllocation(thread, kArrayCid)));
   TypeArguments& element_type =
       TypeArguments::CheckedHandle(zone, arguments.ArgAt(1));
   // An Array is raw or takes one type argument. However, its type argument
@@ -506,9 +516,9 @@ DEFINE_RUNTIME_ENTRY(AllocateTypedData, 2) {
   } else if (len > max) {
     Exceptions::ThrowOOM();
   }
-  const auto& typed_data =
-      TypedData::Handle(zone, TypedData::New(cid, static_cast<intptr_t>(len),
-                                             SpaceForRuntimeAllocation()));
+  const auto& typed_data = TypedData::Handle(
+      zone, TypedData::New(cid, static_cast<intptr_t>(len),
+                           SpaceForRuntimeAllocation(thread, cid)));
   arguments.SetReturn(typed_data);
   RuntimeAllocationEpilogue(thread);
 }
@@ -548,7 +558,8 @@ DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
 #endif
   ASSERT(cls.is_allocate_finalized());
   const Instance& instance = Instance::Handle(
-      zone, Instance::NewAlreadyFinalized(cls, SpaceForRuntimeAllocation()));
+      zone, Instance::NewAlreadyFinalized(
+                cls, SpaceForRuntimeAllocation(thread, cls.id())));
   if (cls.NumTypeArguments() == 0) {
     // No type arguments required for a non-parameterized type.
     ASSERT(Instance::CheckedHandle(zone, arguments.ArgAt(1)).IsNull());
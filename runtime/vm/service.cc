@@ -1671,6 +1671,15 @@ static void GetMemoryUsage(Thread* thread, JSONStream* js) {
   thread->isolate()->PrintMemoryUsageJSON(js);
 }
 
+static const MethodParameter* const get_gc_statistics_params[] = {
+    ISOLATE_PARAMETER,
+    nullptr,
+};
+
+static void GetGCStatistics(Thread* thread, JSONStream* js) {
+  thread->isolate_group()->heap()->PrintGCStatisticsJSON(js);
+}
+
 static const MethodParameter* const get_isolate_group_memory_usage_params[] = {
     ISOLATE_GROUP_PARAMETER,
     nullptr,
@@ -6248,6 +6257,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_cpu_samples_params },
   { "getFlagList", GetFlagList,
     get_flag_list_params },
+  { "_getGCStatistics", GetGCStatistics,
+    get_gc_statistics_params },
   { "_getHeapMap", GetHeapMap,
     get_heap_map_params },
   { "_getImplementationFields", GetImplementationFields,
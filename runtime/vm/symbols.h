@@ -162,11 +162,13 @@ class ObjectPointerVisitor;
   V(FutureOr, "FutureOr")                                                      \
   V(FutureValue, "Future.value")                                               \
   V(GetCall, "get:call")                                                       \
+  V(GetHashCode, "get:hashCode")                                               \
   V(GetLength, "get:length")                                                   \
   V(GetRuntimeType, "get:runtimeType")                                         \
   V(GetterPrefix, "get:")                                                      \
   V(Get_fieldNames, "get:_fieldNames")                                         \
   V(GreaterEqualOperator, ">=")                                                \
+  V(HashCode, "hashCode")                                                      \
   V(HaveSameRuntimeType, "_haveSameRuntimeType")                               \
   V(ICData, "ICData")                                                          \
   V(Identical, "identical")                                                    \
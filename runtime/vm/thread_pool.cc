@@ -118,6 +118,14 @@ void ThreadPool::DeleteLastDeadWorker() {
 }
 
 bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
+  OSThread* os_thread = OSThread::TryCurrent();
+  if (os_thread != nullptr) {
+    auto worker = static_cast<Worker*>(os_thread->owning_thread_pool_worker_);
+    if (worker != nullptr && worker->pool_ == this) {
+      return ScheduleLocalTask(worker, std::move(task));
+    }
+  }
+
   Worker* new_worker = nullptr;
   {
     MutexLocker ml(&pool_mutex_);
@@ -183,43 +191,138 @@ void ThreadPool::MarkCurrentWorkerAsUnBlocked() {
   }
 }
 
-std::unique_ptr<ThreadPool::Task> ThreadPool::TakeNextAvailableTaskLocked() {
-  std::unique_ptr<Task> task(tasks_.RemoveFirst());
+bool ThreadPool::ScheduleLocalTask(Worker* worker,
+                                   std::unique_ptr<Task> task) {
+  if (shutting_down_) {
+    return false;
+  }
+  pending_tasks_++;
+  worker->PushLocal(task.release());
+
+  // A sleeping worker announces itself before checking [pending_tasks_] one
+  // last time, and we check for sleeping workers after incrementing it, so
+  // at least one of us sees the other. Otherwise take the lock only if the
+  // pool could grow and there are fewer idle workers than pending tasks, as
+  // in [NotifyWorkersLocked].
+  if (sleeping_workers_ == 0) {
+    if (count_idle_ >= pending_tasks_) return true;
+    const uintptr_t max_pool_size = max_pool_size_;
+    if (max_pool_size > 0 && count_idle_ + count_running_ >= max_pool_size) {
+      return true;
+    }
+  }
+
+  Worker* new_worker = nullptr;
+  {
+    MutexLocker ml(&pool_mutex_);
+    new_worker = NotifyWorkersLocked();
+  }
+  if (new_worker != nullptr) {
+    new_worker->StartThread();
+  }
+  return true;
+}
+
+void ThreadPool::RunTasksLocked(MutexLocker* ml, Worker* worker) {
+  bool local_first = true;
+  while (true) {
+    std::unique_ptr<Task> task(TakeTaskLocked(worker, local_first));
+    if (task == nullptr) {
+      return;
+    }
+    MutexUnlocker mls(ml);
+    local_first = RunLocalTasks(worker, std::move(task));
+  }
+}
+
+// Runs [task] and then the tasks it (transitively) scheduled on this worker,
+// without taking the pool lock. Returns false if it stopped early to give the
+// tasks in the global queue a chance to run.
+bool ThreadPool::RunLocalTasks(Worker* worker, std::unique_ptr<Task> task) {
+  intptr_t lifo_runs = 0;
+  for (intptr_t runs = 1;; runs++) {
+    task->Run();
+    ASSERT(Isolate::Current() == nullptr);
+    task.reset();  // Delete the task while unlocked.
+
+    if (runs == kMaxLocalTaskRuns) {
+      return false;
+    }
+    bool from_lifo = false;
+    task.reset(worker->TakeLocal(lifo_runs < kMaxLifoSlotRuns, &from_lifo));
+    if (task == nullptr) {
+      return true;
+    }
+    pending_tasks_--;
+    lifo_runs = from_lifo ? lifo_runs + 1 : 0;
+  }
+}
+
+ThreadPool::Task* ThreadPool::TakeTaskLocked(Worker* worker,
+                                             bool local_first) {
+  bool from_lifo = false;
+  Task* task = nullptr;
+  if (local_first) {
+    task = worker->TakeLocal(/*lifo_first=*/true, &from_lifo);
+  }
+  if (task == nullptr && !tasks_.IsEmpty()) {
+    task = tasks_.RemoveFirst();
+  }
+  if (task == nullptr && !local_first) {
+    task = worker->TakeLocal(/*lifo_first=*/false, &from_lifo);
+  }
+  if (task == nullptr) {
+    task = StealTaskLocked(worker);
+  }
+  if (task == nullptr) {
+    return nullptr;
+  }
   pending_tasks_--;
   if (pending_tasks_ > 0 && !idle_workers_.IsEmpty()) {
     // Wake up one more worker if more tasks are left.
-    idle_workers_.Last()->Wakeup();
+    WakeIdleWorkerLocked();
   }
   return task;
 }
 
+ThreadPool::Task* ThreadPool::StealTaskLocked(Worker* thief) {
+  // Prefer the oldest tasks of other workers over the tasks they are about to
+  // run next. Those are only taken so that a busy or blocked worker cannot
+  // hold on to a task while other workers have nothing to do.
+  for (bool include_lifo_slot : {false, true}) {
+    for (auto victim : running_workers_) {
+      if (victim == thief) continue;
+      if (Task* task = victim->Steal(include_lifo_slot)) return task;
+    }
+    for (auto victim : idle_workers_) {
+      if (victim == thief) continue;
+      if (Task* task = victim->Steal(include_lifo_slot)) return task;
+    }
+  }
+  return nullptr;
+}
+
 void ThreadPool::WorkerLoop(Worker* worker) {
   Worker* previous_dead_worker = nullptr;
 
   while (true) {
     MutexLocker ml(&pool_mutex_);
 
-    if (!tasks_.IsEmpty()) {
+    if (TasksWaitingToRunLocked()) {
       IdleToRunningLocked(worker);
-      while (!tasks_.IsEmpty()) {
-        auto task = TakeNextAvailableTaskLocked();
-        MutexUnlocker mls(&ml);
-        task->Run();
-        ASSERT(Isolate::Current() == nullptr);
-        task.reset();  // Delete the task while unlocked.
-      }
+      RunTasksLocked(&ml, worker);
       RunningToIdleLocked(worker);
     }
 
     if (running_workers_.IsEmpty()) {
       ASSERT(tasks_.IsEmpty());
       OnEnterIdleLocked(&ml, worker);
-      if (!tasks_.IsEmpty()) {
+      if (TasksWaitingToRunLocked()) {
         continue;
       }
     }
 
-    if (shutting_down_) {
+    if (shutting_down_ && !TasksWaitingToRunLocked()) {
       previous_dead_worker = IdleToDeadLocked(worker);
       break;
     }
@@ -227,17 +330,26 @@ void ThreadPool::WorkerLoop(Worker* worker) {
     // Sleep until we get a new task, we time out or we're shutdown.
     const int64_t idle_start = OS::GetCurrentMonotonicMicros();
     bool done = false;
+    worker->sleeping_ = true;
+    sleeping_workers_++;
     while (!done) {
+      // We have to drain all pending tasks, including those scheduled by
+      // other workers on their own queues since we last looked.
+      if (TasksWaitingToRunLocked()) break;
+
       const auto result = worker->Sleep(ComputeTimeout(idle_start));
 
-      // We have to drain all pending tasks.
-      if (!tasks_.IsEmpty()) break;
+      if (TasksWaitingToRunLocked()) break;
 
       if (shutting_down_ || result == ConditionVariable::kTimedOut) {
         done = true;
         break;
       }
     }
+    if (worker->sleeping_) {
+      worker->sleeping_ = false;
+      sleeping_workers_--;
+    }
     if (done) {
       previous_dead_worker = IdleToDeadLocked(worker);
       break;
@@ -261,6 +373,7 @@ void ThreadPool::IdleToRunningLocked(Worker* worker) {
 
 void ThreadPool::RunningToIdleLocked(Worker* worker) {
   ASSERT(tasks_.IsEmpty());
+  ASSERT(worker->lifo_slot_ == nullptr && worker->local_tasks_.IsEmpty());
 
   ASSERT(running_workers_.ContainsForDebugging(worker));
   running_workers_.Remove(worker);
@@ -271,6 +384,7 @@ void ThreadPool::RunningToIdleLocked(Worker* worker) {
 
 ThreadPool::Worker* ThreadPool::IdleToDeadLocked(Worker* worker) {
   ASSERT(tasks_.IsEmpty());
+  ASSERT(worker->lifo_slot_ == nullptr && worker->local_tasks_.IsEmpty());
   Worker* previous_dead = last_dead_worker_;
 
   ASSERT(idle_workers_.ContainsForDebugging(worker));
@@ -303,12 +417,17 @@ ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task) {
   pending_tasks_++;
   ASSERT(pending_tasks_ >= 1);
 
+  return NotifyWorkersLocked();
+}
+
+ThreadPool::Worker* ThreadPool::NotifyWorkersLocked() {
   // Notify existing idle worker (if available).
   if (count_idle_ >= pending_tasks_) {
-    ASSERT(!idle_workers_.IsEmpty());
-    // We always notify only the last worker which became idle. It will wake up
-    // more workers if needed.
-    idle_workers_.Last()->Wakeup();
+    // We always notify only one worker. It will wake up more workers if
+    // needed.
+    if (!idle_workers_.IsEmpty()) {
+      WakeIdleWorkerLocked();
+    }
     return nullptr;
   }
 
@@ -316,9 +435,9 @@ ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task) {
   // new one.
   if (max_pool_size_ > 0 && (count_idle_ + count_running_) >= max_pool_size_) {
     if (!idle_workers_.IsEmpty()) {
-      // We always notify only the last worker which became idle. It will
-      // wake up more workers if needed.
-      idle_workers_.Last()->Wakeup();
+      // We always notify only one worker. It will wake up more workers if
+      // needed.
+      WakeIdleWorkerLocked();
     }
     return nullptr;
   }
@@ -330,9 +449,62 @@ ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task) {
   return new_worker;
 }
 
+void ThreadPool::WakeIdleWorkerLocked() {
+  ASSERT(!idle_workers_.IsEmpty());
+  // Prefer the last worker which went to sleep. Idle workers which are not
+  // sleeping will look for tasks anyway.
+  Worker* sleeper = nullptr;
+  for (auto worker : idle_workers_) {
+    if (worker->sleeping_) {
+      sleeper = worker;
+    }
+  }
+  if (sleeper == nullptr) {
+    idle_workers_.Last()->Wakeup();
+    return;
+  }
+  sleeper->sleeping_ = false;
+  sleeping_workers_--;
+  sleeper->Wakeup();
+}
+
 ThreadPool::Worker::Worker(ThreadPool* pool)
     : pool_(pool), join_id_(OSThread::kInvalidThreadJoinId) {}
 
+ThreadPool::Task* ThreadPool::Worker::TakeLocal(bool lifo_first,
+                                                bool* from_lifo) {
+  Task* task = nullptr;
+  if (lifo_first) {
+    task = lifo_slot_.exchange(nullptr, std::memory_order_acq_rel);
+    if (task != nullptr) {
+      *from_lifo = true;
+      return task;
+    }
+  }
+  *from_lifo = false;
+  // The owner takes from the top as well, so that tasks which were pushed out
+  // of the LIFO slot run in the order they were scheduled.
+  if (local_tasks_.Steal(&task)) {
+    return task;
+  }
+  if (!lifo_first) {
+    task = lifo_slot_.exchange(nullptr, std::memory_order_acq_rel);
+    *from_lifo = task != nullptr;
+  }
+  return task;
+}
+
+ThreadPool::Task* ThreadPool::Worker::Steal(bool include_lifo_slot) {
+  Task* task = nullptr;
+  if (local_tasks_.Steal(&task)) {
+    return task;
+  }
+  if (include_lifo_slot) {
+    return lifo_slot_.exchange(nullptr, std::memory_order_acq_rel);
+  }
+  return nullptr;
+}
+
 void ThreadPool::Worker::StartThread() {
   OSThread::Start("DartWorker", &Worker::Main, reinterpret_cast<uword>(this));
 }
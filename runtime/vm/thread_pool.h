@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_THREAD_POOL_H_
 #define RUNTIME_VM_THREAD_POOL_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -14,6 +15,7 @@
 #include "vm/intrusive_dlist.h"
 #include "vm/lockers.h"
 #include "vm/os_thread.h"
+#include "vm/work_stealing_deque.h"
 
 namespace dart {
 
@@ -43,6 +45,10 @@ class ThreadPool {
   virtual ~ThreadPool();
 
   // Runs a task on the thread pool.
+  //
+  // Tasks scheduled from a worker of this pool are queued on that worker
+  // without taking the pool lock. The most recent one runs next on the same
+  // worker; idle workers steal the others.
   template <typename T, typename... Args>
   bool Run(Args&&... args) {
     return RunImpl(std::unique_ptr<Task>(new T(std::forward<Args>(args)...)));
@@ -106,6 +112,23 @@ class ThreadPool {
 
     void Wakeup() { wakeup_cv_.Notify(); }
 
+    // Owner only. Makes [task] the next task to run on this worker, moving
+    // the previous occupant of the LIFO slot to the local queue.
+    void PushLocal(Task* task) {
+      Task* previous = lifo_slot_.exchange(task, std::memory_order_acq_rel);
+      if (previous != nullptr) {
+        local_tasks_.Push(previous);
+      }
+    }
+
+    // Owner only. Takes the task in the LIFO slot (if [lifo_first]) or the
+    // oldest task of the local queue.
+    Task* TakeLocal(bool lifo_first, bool* from_lifo);
+
+    // Any thread. Takes the oldest task of the local queue or, if
+    // [include_lifo_slot], the task in the LIFO slot.
+    Task* Steal(bool include_lifo_slot);
+
     // The main entry point for new worker threads.
     static void Main(uword args);
 
@@ -117,6 +140,14 @@ class ThreadPool {
     bool is_blocked_ = false;
     ConditionVariable wakeup_cv_;
 
+    // Tasks scheduled by tasks running on this worker.
+    WorkStealingDeque<Task*> local_tasks_;
+    std::atomic<Task*> lifo_slot_ = {nullptr};
+
+    // Whether the worker waits for new tasks and nobody has woken it yet.
+    // Protected by the pool mutex.
+    bool sleeping_ = false;
+
     DISALLOW_COPY_AND_ASSIGN(Worker);
   };
 
@@ -130,7 +161,7 @@ class ThreadPool {
   bool ShuttingDownLocked() { return shutting_down_; }
 
   // Whether new tasks are ready to be run.
-  bool TasksWaitingToRunLocked() { return !tasks_.IsEmpty(); }
+  bool TasksWaitingToRunLocked() { return pending_tasks_ > 0; }
 
  private:
   static void WorkerThreadExit(ThreadPool* pool, ThreadPool::Worker* worker);
@@ -142,8 +173,14 @@ class ThreadPool {
   void WorkerLoop(Worker* worker);
 
   Worker* ScheduleTaskLocked(std::unique_ptr<Task> task);
+  bool ScheduleLocalTask(Worker* worker, std::unique_ptr<Task> task);
+  DART_WARN_UNUSED_RESULT Worker* NotifyWorkersLocked();
+  void WakeIdleWorkerLocked();
 
-  std::unique_ptr<Task> TakeNextAvailableTaskLocked();
+  void RunTasksLocked(MutexLocker* ml, Worker* worker);
+  bool RunLocalTasks(Worker* worker, std::unique_ptr<Task> task);
+  Task* TakeTaskLocked(Worker* worker, bool local_first);
+  Task* StealTaskLocked(Worker* thief);
 
   void IdleToRunningLocked(Worker* worker);
   void RunningToIdleLocked(Worker* worker);
@@ -156,17 +193,29 @@ class ThreadPool {
 
   void DeleteLastDeadWorker();
 
+  // Consecutive tasks a worker runs from its own queues before it checks
+  // the global queue again, and how many of those may come from the LIFO
+  // slot in a row before older local tasks get a turn.
+  static constexpr intptr_t kMaxLocalTaskRuns = 61;
+  static constexpr intptr_t kMaxLifoSlotRuns = 3;
+
   mutable Mutex pool_mutex_;
-  bool shutting_down_ = false;
-  uint64_t count_running_ = 0;
-  uint64_t count_idle_ = 0;
+  // The following are only modified with [pool_mutex_] held, but workers
+  // scheduling tasks on their own queues read them without it.
+  std::atomic<bool> shutting_down_ = {false};
+  std::atomic<uint64_t> count_running_ = {0};
+  std::atomic<uint64_t> count_idle_ = {0};
   uint64_t count_dead_ = 0;
   WorkerList running_workers_;
   WorkerList idle_workers_;
 
   Worker* last_dead_worker_ = nullptr;
 
-  uint64_t pending_tasks_ = 0;
+  // Tasks in [tasks_] and in the workers' own queues which have not been
+  // taken yet. Incremented before a task is published and decremented after
+  // it is taken, so it never undercounts.
+  std::atomic<uint64_t> pending_tasks_ = {0};
+  std::atomic<uint64_t> sleeping_workers_ = {0};
   TaskList tasks_;
 
   Monitor exit_monitor_;
@@ -176,7 +225,7 @@ class ThreadPool {
   // invoked by the last exiting worker.
   std::function<void(void)> shutdown_complete_callback_;
 
-  uintptr_t max_pool_size_ = 0;
+  std::atomic<uintptr_t> max_pool_size_ = {0};
 
   DISALLOW_COPY_AND_ASSIGN(ThreadPool);
 };
@@ -257,4 +257,64 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+class CountTask : public ThreadPool::Task {
+ public:
+  CountTask(Monitor* sync, int* count) : sync_(sync), count_(count) {}
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    (*count_)++;
+    ml.Notify();
+  }
+
+ private:
+  Monitor* sync_;
+  int* count_;
+};
+
+// Schedules tasks on its own worker and then waits for them, so they have to
+// be stolen by another worker.
+class WaitForChildrenTask : public ThreadPool::Task {
+ public:
+  WaitForChildrenTask(ThreadPool* pool, Monitor* sync, int children, bool* done)
+      : pool_(pool), sync_(sync), children_(children), done_(done) {}
+
+  virtual void Run() {
+    Monitor child_sync;
+    int count = 0;
+    for (int i = 0; i < children_; i++) {
+      pool_->Run<CountTask>(&child_sync, &count);
+    }
+    {
+      MonitorLocker ml(&child_sync);
+      while (count < children_) {
+        ml.Wait();
+      }
+    }
+    MonitorLocker ml(sync_);
+    *done_ = true;
+    ml.Notify();
+  }
+
+ private:
+  ThreadPool* pool_;
+  Monitor* sync_;
+  int children_;
+  bool* done_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_StealFromBusyWorker) {
+  ThreadPool thread_pool(/*max_pool_size=*/2);
+  Monitor sync;
+  bool done = false;
+  thread_pool.Run<WaitForChildrenTask>(&thread_pool, &sync, 100, &done);
+  {
+    MonitorLocker ml(&sync);
+    while (!done) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(2U, thread_pool.workers_started());
+}
+
 }  // namespace dart
@@ -90,6 +90,24 @@ static void Unmap(uword start, uword end) {
   }
 }
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+// Asks the kernel to back the region with transparent huge pages wherever it
+// covers whole, aligned huge pages. Heap pages are smaller than a huge page,
+// but adjacent mappings with the same advice are merged into one area that
+// khugepaged can collapse.
+static void AdviseHugePages(void* address, intptr_t size) {
+#if defined(MADV_HUGEPAGE)
+  if (!FLAG_transparent_huge_pages) {
+    return;
+  }
+  if (madvise(address, size, MADV_HUGEPAGE) != 0) {
+    // E.g., a kernel built without THP. Not fatal: we just don't get them.
+    LOG_INFO("madvise(%p, 0x%" Px ", MADV_HUGEPAGE) failed\n", address, size);
+  }
+#endif
+}
+#endif
+
 static void* GenericMapAligned(void* hint,
                                int prot,
                                intptr_t size,
@@ -314,6 +332,19 @@ void VirtualMemory::Init() {
                                     compressed_heap_->size());
 #endif  // defined(DART_COMPRESSED_POINTERS)
 #if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  if (FLAG_transparent_huge_pages) {
+    FILE* thp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (thp != nullptr) {
+      char mode[64] = {0};
+      if ((fgets(mode, sizeof(mode), thp) != nullptr) &&
+          (strstr(mode, "[never]") != nullptr)) {
+        OS::PrintErr(
+            "warning: --transparent_huge_pages has no effect because "
+            "transparent huge pages are disabled in the kernel\n");
+      }
+      fclose(thp);
+    }
+  }
   FILE* fp = fopen("/proc/sys/vm/max_map_count", "r");
   if (fp != nullptr) {
     size_t max_map_count = 0;
@@ -385,6 +416,9 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
       return nullptr;
     }
     Commit(region.pointer(), region.size());
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+    AdviseHugePages(region.pointer(), region.size());
+#endif
     return new VirtualMemory(region, region);
   }
 #endif  // defined(DART_COMPRESSED_POINTERS)
@@ -454,6 +488,9 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
 #define PR_SET_VMA_ANON_NAME 0
 #endif
   prctl(PR_SET_VMA, PR_SET_VMA_ANON_NAME, address, size, name);
+  if (!is_executable) {
+    AdviseHugePages(address, size);
+  }
 #endif
 
   MemoryRegion region(reinterpret_cast<void*>(address), size);
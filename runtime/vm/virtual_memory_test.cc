@@ -89,6 +89,29 @@ VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   }
 }
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+VM_UNIT_TEST_CASE(DontNeedIsExactWithHugePages) {
+  const intptr_t kHugePageSize = 2 * MB;
+  VirtualMemory* vm = VirtualMemory::AllocateAligned(
+      2 * kHugePageSize, kHugePageSize, false, false, "test");
+  EXPECT(vm != nullptr);
+  char* buf = reinterpret_cast<char*>(vm->address());
+  memset(buf, 'x', vm->size());
+
+  {
+    // Exactly the requested range is released, even though it splits a huge
+    // page.
+    SetFlagScope<bool> sfs(&FLAG_transparent_huge_pages, true);
+    VirtualMemory::DontNeed(buf + kPageSize, kPageSize);
+    EXPECT_EQ('x', buf[kPageSize - 1]);
+    EXPECT(IsZero(buf + kPageSize, buf + 2 * kPageSize));
+    EXPECT_EQ('x', buf[2 * kPageSize]);
+  }
+
+  delete vm;
+}
+#endif  // defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+
 #if !defined(DART_TARGET_OS_FUCHSIA)
 // TODO(https://dartbug.com/52579): Reenable on Fuchsia.
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_WORK_STEALING_DEQUE_H_
+#define RUNTIME_VM_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+
+#include "platform/allocation.h"
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// A double-ended queue with a single owner and any number of thieves (Chase
+// and Lev, "Dynamic Circular Work-Stealing Deque").
+//
+// The owner pushes and pops at the bottom without taking any locks. Other
+// threads steal from the top, contending with each other (and with the owner
+// only for the last element) through a single compare-and-swap.
+//
+// The backing array grows as needed. Retired arrays are kept alive until the
+// deque is destroyed because a thief may still be reading from them.
+//
+// T must be trivially copyable; in practice it is a pointer.
+template <typename T>
+class WorkStealingDeque : public MallocAllocated {
+ public:
+  explicit WorkStealingDeque(intptr_t initial_capacity = 64)
+      : top_(0), bottom_(0), array_(new Array(initial_capacity, nullptr)) {}
+
+  ~WorkStealingDeque() {
+    Array* array = array_.load(std::memory_order_relaxed);
+    while (array != nullptr) {
+      Array* retired = array->retired();
+      delete array;
+      array = retired;
+    }
+  }
+
+  // Owner only.
+  void Push(T value) {
+    intptr_t bottom = bottom_.load(std::memory_order_relaxed);
+    intptr_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->capacity() - 1) {
+      array = Grow(array, top, bottom);
+    }
+    array->Put(bottom, value);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only. Takes the most recently pushed element. Returns false if the
+  // deque was empty or the last element was stolen concurrently.
+  bool Pop(T* value) {
+    intptr_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    // seq_cst instead of standalone fences, which ThreadSanitizer does not
+    // model.
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    intptr_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    *value = array->Get(bottom);
+    if (top == bottom) {
+      // Last element: race against thieves.
+      bool won = top_.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // Any thread. Takes the least recently pushed element. Returns false if the
+  // deque was empty or another thread took the element first.
+  bool Steal(T* value) {
+    intptr_t top = top_.load(std::memory_order_seq_cst);
+    intptr_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+      return false;
+    }
+    Array* array = array_.load(std::memory_order_acquire);
+    T result = array->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    *value = result;
+    return true;
+  }
+
+  // Approximate when called concurrently with other operations.
+  intptr_t Size() const {
+    intptr_t bottom = bottom_.load(std::memory_order_relaxed);
+    intptr_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? bottom - top : 0;
+  }
+  bool IsEmpty() const { return Size() == 0; }
+
+ private:
+  class Array : public MallocAllocated {
+   public:
+    Array(intptr_t capacity, Array* retired)
+        : capacity_(Utils::RoundUpToPowerOfTwo(capacity)),
+          mask_(capacity_ - 1),
+          data_(new std::atomic<T>[capacity_]),
+          retired_(retired) {}
+    ~Array() { delete[] data_; }
+
+    intptr_t capacity() const { return capacity_; }
+    Array* retired() const { return retired_; }
+
+    T Get(intptr_t i) const {
+      return data_[i & mask_].load(std::memory_order_relaxed);
+    }
+    void Put(intptr_t i, T value) {
+      data_[i & mask_].store(value, std::memory_order_relaxed);
+    }
+
+   private:
+    const intptr_t capacity_;
+    const intptr_t mask_;
+    std::atomic<T>* const data_;
+    Array* const retired_;
+
+    DISALLOW_COPY_AND_ASSIGN(Array);
+  };
+
+  Array* Grow(Array* array, intptr_t top, intptr_t bottom) {
+    Array* grown = new Array(2 * array->capacity(), array);
+    for (intptr_t i = top; i < bottom; i++) {
+      grown->Put(i, array->Get(i));
+    }
+    array_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  static constexpr intptr_t kCacheLineSize = 64;
+
+  // Thieves update top_ and the owner updates bottom_; keep them on separate
+  // cache lines.
+  std::atomic<intptr_t> top_;
+  alignas(kCacheLineSize) std::atomic<intptr_t> bottom_;
+  std::atomic<Array*> array_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_WORK_STEALING_DEQUE_H_
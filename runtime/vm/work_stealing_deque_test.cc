@@ -0,0 +1,118 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/work_stealing_deque.h"
+#include "platform/assert.h"
+#include "vm/lockers.h"
+#include "vm/thread_pool.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+VM_UNIT_TEST_CASE(WorkStealingDeque_OwnerOnly) {
+  WorkStealingDeque<intptr_t*> deque(2);
+  intptr_t values[100];
+  EXPECT(deque.IsEmpty());
+  for (intptr_t i = 0; i < 100; i++) {
+    values[i] = i;
+    deque.Push(&values[i]);
+  }
+  EXPECT_EQ(100, deque.Size());
+
+  // The owner pops in LIFO order, thieves steal in FIFO order.
+  intptr_t* value;
+  EXPECT(deque.Pop(&value));
+  EXPECT_EQ(99, *value);
+  EXPECT(deque.Steal(&value));
+  EXPECT_EQ(0, *value);
+  for (intptr_t i = 98; i >= 1; i--) {
+    EXPECT(deque.Pop(&value));
+    EXPECT_EQ(i, *value);
+  }
+  EXPECT(deque.IsEmpty());
+  EXPECT(!deque.Pop(&value));
+  EXPECT(!deque.Steal(&value));
+}
+
+class StealTask : public ThreadPool::Task {
+ public:
+  StealTask(WorkStealingDeque<intptr_t*>* deque,
+            RelaxedAtomic<bool>* done,
+            RelaxedAtomic<intptr_t>* sum,
+            RelaxedAtomic<intptr_t>* count,
+            Monitor* monitor,
+            intptr_t* running)
+      : deque_(deque),
+        done_(done),
+        sum_(sum),
+        count_(count),
+        monitor_(monitor),
+        running_(running) {}
+
+  virtual void Run() {
+    intptr_t* value;
+    while (!done_->load() || !deque_->IsEmpty()) {
+      if (deque_->Steal(&value)) {
+        sum_->fetch_add(*value);
+        count_->fetch_add(1);
+      }
+    }
+    MonitorLocker ml(monitor_);
+    (*running_)--;
+    ml.Notify();
+  }
+
+ private:
+  WorkStealingDeque<intptr_t*>* deque_;
+  RelaxedAtomic<bool>* done_;
+  RelaxedAtomic<intptr_t>* sum_;
+  RelaxedAtomic<intptr_t>* count_;
+  Monitor* monitor_;
+  intptr_t* running_;
+};
+
+VM_UNIT_TEST_CASE(WorkStealingDeque_Concurrent) {
+  const intptr_t kNumThieves = 4;
+  const intptr_t kNumValues = 100000;
+
+  WorkStealingDeque<intptr_t*> deque(4);
+  intptr_t* values = new intptr_t[kNumValues];
+  RelaxedAtomic<bool> done = false;
+  RelaxedAtomic<intptr_t> sum = 0;
+  RelaxedAtomic<intptr_t> count = 0;
+  Monitor monitor;
+  intptr_t running = kNumThieves;
+  for (intptr_t i = 0; i < kNumThieves; i++) {
+    Dart::thread_pool()->Run<StealTask>(&deque, &done, &sum, &count, &monitor,
+                                        &running);
+  }
+
+  // Every value is taken exactly once, either by the owner or by a thief.
+  intptr_t* value;
+  for (intptr_t i = 0; i < kNumValues; i++) {
+    values[i] = i;
+    deque.Push(&values[i]);
+    if ((i % 3) == 0 && deque.Pop(&value)) {
+      sum.fetch_add(*value);
+      count.fetch_add(1);
+    }
+  }
+  while (deque.Pop(&value)) {
+    sum.fetch_add(*value);
+    count.fetch_add(1);
+  }
+  done = true;
+  {
+    MonitorLocker ml(&monitor);
+    while (running > 0) {
+      ml.Wait();
+    }
+  }
+
+  EXPECT_EQ(kNumValues, count.load());
+  EXPECT_EQ(kNumValues * (kNumValues - 1) / 2, sum.load());
+  delete[] values;
+}
+
+}  // namespace dart
@@ -667,7 +667,7 @@ class RawDatagramSocket {
 @patch
 class _SecureFilter {
   @patch
-  factory _SecureFilter._() {
+  factory _SecureFilter._(int bufferSize) {
     throw UnsupportedError("_SecureFilter._SecureFilter");
   }
 }
@@ -722,6 +722,7 @@ class RawZLibFilter {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) {
     throw UnsupportedError("_newZLibDeflateFilter");
   }
@@ -129,6 +129,14 @@ class RawReceivePort {
   @patch
   factory RawReceivePort([Function? handler, String debugName = '']) =>
       _unsupported();
+
+  @patch
+  factory RawReceivePort.bounded(
+    int capacity, {
+    Function? handler,
+    String debugName = '',
+    bool blockSenders = false,
+  }) => _unsupported();
 }
 
 @patch
@@ -663,7 +663,7 @@ class RawDatagramSocket {
 @patch
 class _SecureFilter {
   @patch
-  factory _SecureFilter._() {
+  factory _SecureFilter._(int bufferSize) {
     throw UnsupportedError("_SecureFilter._SecureFilter");
   }
 }
@@ -718,6 +718,7 @@ class RawZLibFilter {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) {
     throw UnsupportedError("_newZLibDeflateFilter");
   }
@@ -162,6 +162,16 @@ class RawReceivePort {
   factory RawReceivePort([Function? handler, String debugName = '']) {
     throw UnsupportedError('new RawReceivePort');
   }
+
+  @patch
+  factory RawReceivePort.bounded(
+    int capacity, {
+    Function? handler,
+    String debugName = '',
+    bool blockSenders = false,
+  }) {
+    throw UnsupportedError('new RawReceivePort.bounded');
+  }
 }
 
 @patch
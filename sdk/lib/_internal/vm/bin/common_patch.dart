@@ -29,7 +29,7 @@ import "dart:developer" show registerExtension;
 
 import "dart:isolate" show RawReceivePort, ReceivePort, SendPort;
 
-import "dart:math" show min;
+import "dart:math" show max, min;
 
 import "dart:nativewrappers" show NativeFieldWrapperClass1;
 
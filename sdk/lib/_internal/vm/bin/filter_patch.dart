@@ -4,6 +4,9 @@
 
 part of "common_patch.dart";
 
+@pragma("vm:external-name", "Filter_NewCompressPort")
+external SendPort _newCompressPort();
+
 base class _FilterImpl extends NativeFieldWrapperClass1
     implements RawZLibFilter {
   @pragma("vm:external-name", "Filter_Process")
@@ -32,6 +35,10 @@ base class _ZLibInflateFilter extends _FilterImpl {
 }
 
 base class _ZLibDeflateFilter extends _FilterImpl {
+  // Compresses blocks for the filters of this isolate with more than one
+  // thread.
+  static final SendPort _compressPort = _newCompressPort();
+
   _ZLibDeflateFilter(
     bool gzip,
     int level,
@@ -40,8 +47,19 @@ base class _ZLibDeflateFilter extends _FilterImpl {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) {
-    _init(gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+    _init(
+      gzip,
+      level,
+      windowBits,
+      memLevel,
+      strategy,
+      dictionary,
+      raw,
+      threads,
+      threads > 1 ? _compressPort : null,
+    );
   }
   @pragma("vm:external-name", "Filter_CreateZLibDeflate")
   external void _init(
@@ -52,6 +70,8 @@ base class _ZLibDeflateFilter extends _FilterImpl {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
+    SendPort? compressPort,
   );
 }
 
@@ -66,6 +86,7 @@ class RawZLibFilter {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) => _ZLibDeflateFilter(
     gzip,
     level,
@@ -74,6 +95,7 @@ class RawZLibFilter {
     strategy,
     dictionary,
     raw,
+    threads,
   );
   @patch
   static RawZLibFilter _makeZLibInflateFilter(
@@ -13,7 +13,7 @@ class SecureSocket {
 @patch
 class _SecureFilter {
   @patch
-  factory _SecureFilter._() => _SecureFilterImpl._();
+  factory _SecureFilter._(int bufferSize) => _SecureFilterImpl._(bufferSize);
 }
 
 @patch
@@ -64,17 +64,25 @@ base class _SecureFilterImpl extends NativeFieldWrapperClass1
     implements _SecureFilter {
   // Performance is improved if a full buffer of plaintext fits
   // in the encrypted buffer, when encrypted.
-  // SIZE and ENCRYPTED_SIZE are referenced from C++.
+  static const int defaultSize = 8 * 1024;
+  static const int encryptedOverhead = 2 * 1024;
+  static const int minSize = 1024;
+  static const int maxSize = 1024 * 1024 - encryptedOverhead;
+
+  // bufferSize and encryptedBufferSize are referenced from C++.
   @pragma("vm:entry-point")
-  static final int SIZE = 8 * 1024;
+  final int bufferSize;
   @pragma("vm:entry-point")
-  static final int ENCRYPTED_SIZE = 10 * 1024;
+  final int encryptedBufferSize;
 
-  _SecureFilterImpl._() {
+  _SecureFilterImpl._(this.bufferSize)
+    : encryptedBufferSize = bufferSize + encryptedOverhead {
     buffers = <_ExternalBuffer>[
       for (int i = 0; i < _RawSecureSocket.bufferCount; ++i)
         _ExternalBuffer(
-          _RawSecureSocket._isBufferEncrypted(i) ? ENCRYPTED_SIZE : SIZE,
+          _RawSecureSocket._isBufferEncrypted(i)
+              ? encryptedBufferSize
+              : bufferSize,
         ),
     ];
   }
@@ -217,6 +225,7 @@ class SecurityContext {
 base class _SecurityContext extends NativeFieldWrapperClass1
     implements SecurityContext {
   bool _allowLegacyUnsafeRenegotiation = false;
+  int _bufferSize = _SecureFilterImpl.defaultSize;
 
   _SecurityContext(bool withTrustedRoots) {
     _createNativeContext();
@@ -241,6 +250,17 @@ base class _SecurityContext extends NativeFieldWrapperClass1
         _getMinimumProtocolVersion(),
       );
 
+  set bufferSize(int size) {
+    _bufferSize = RangeError.checkValueInInterval(
+      size,
+      _SecureFilterImpl.minSize,
+      _SecureFilterImpl.maxSize,
+      "bufferSize",
+    );
+  }
+
+  int get bufferSize => _bufferSize;
+
   @pragma("vm:external-name", "SecurityContext_Allocate")
   external void _createNativeContext();
 
@@ -527,6 +527,19 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   static const int normalTokenBatchSize = 8;
   static const int listeningTokenBatchSize = 2;
 
+  // The maximum number of connections accepted, and of datagrams received,
+  // with a single native call. Keep acceptBatchSize in sync with
+  // kMaxAcceptBatch in socket.cc.
+  static const int acceptBatchSize = 16;
+  static const int receiveBatchSize = 8;
+
+  // Shared buffers filled by [_nativeAccept] and [_nativeRecvFrom].
+  static final _acceptedIds = Int64List(acceptBatchSize);
+  static final _receivedDatagrams = Int64List(1 + 3 * receiveBatchSize);
+  static final _receivedSenders = Uint8List(
+    _InternetAddress._IPv6AddrLength * receiveBatchSize,
+  );
+
   static const Duration _retryDuration = Duration(milliseconds: 250);
   static const Duration _retryDurationLoopback = Duration(milliseconds: 25);
 
@@ -564,6 +577,10 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
 
   // Only used for UDP sockets.
   bool _availableDatagram = false;
+  // Datagrams received by the last batch but not yet returned by [receive].
+  ListQueue<Datagram>? _pendingDatagrams;
+  // The sender of the last datagram received, reused while it does not change.
+  _InternetAddress? _lastSender;
 
   // The number of incoming connections for Listening socket.
   int connections = 0;
@@ -1308,27 +1325,39 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
       } else {
         // If count is null, read as many bytes as possible.
         // Loop here to ensure bytes that arrived while this read was
-        // issued are also read.
-        BytesBuilder builder = BytesBuilder(copy: false);
+        // issued are also read. The bytes are read directly into a single
+        // buffer, which grows geometrically when more bytes arrive, and is
+        // trimmed with one copy at the end if it was not filled exactly.
+        Uint8List buffer = Uint8List(available);
+        int length = 0;
         do {
           assert(available > 0);
-          list = _nativeRead(available);
-          if (list == null) {
+          if (buffer.length - length < available) {
+            final grown = Uint8List(
+              max(2 * buffer.length, length + available),
+            );
+            grown.setRange(0, length, buffer);
+            buffer = grown;
+          }
+          final bytesRead = _nativeReadInto(buffer, length, available);
+          if (bytesRead == 0) {
             break;
           }
-          builder.add(list);
+          length += bytesRead;
           available = _nativeAvailable();
           const MAX_BUFFER_SIZE = 4 * 1024 * 1024;
-          if (builder.length > MAX_BUFFER_SIZE) {
+          if (length > MAX_BUFFER_SIZE) {
             // Don't consume too many bytes, otherwise we risk running
             // out of memory when handling the whole aggregated lot.
             break;
           }
         } while (available > 0);
-        if (builder.isEmpty) {
+        if (length == 0) {
           list = null;
+        } else if (length == buffer.length) {
+          list = buffer;
         } else {
-          list = builder.toBytes();
+          list = buffer.sublist(0, length);
         }
       }
       if (!const bool.fromEnvironment("dart.vm.product")) {
@@ -1345,10 +1374,33 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  // Reads up to [count] available bytes into [buffer] at [offset], and
+  // returns the number of bytes read.
+  int readInto(Uint8List buffer, int offset, int count) {
+    if (isClosing || isClosed) return 0;
+    try {
+      final bytesRead = _nativeReadInto(buffer, offset, count);
+      available = _nativeAvailable();
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+          _nativeGetSocketId(),
+          _SocketProfileType.readBytes,
+          bytesRead,
+        );
+      }
+      return bytesRead;
+    } catch (e) {
+      reportError(e, StackTrace.current, "Read failed");
+      return 0;
+    }
+  }
+
   Datagram? receive() {
     if (isClosing || isClosed) return null;
     try {
-      Datagram? result = _nativeRecvFrom();
+      final pending = _pendingDatagrams ??= ListQueue<Datagram>();
+      if (pending.isEmpty) _receiveDatagrams(pending);
+      Datagram? result = pending.isEmpty ? null : pending.removeFirst();
       if (!const bool.fromEnvironment("dart.vm.product")) {
         _SocketProfile.collectStatistic(
           _nativeGetSocketId(),
@@ -1356,7 +1408,7 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
           result?.data.length,
         );
       }
-      _availableDatagram = _nativeAvailableDatagram();
+      _availableDatagram = pending.isNotEmpty || _nativeAvailableDatagram();
       return result;
     } catch (e) {
       reportError(e, StackTrace.current, "Receive failed");
@@ -1364,6 +1416,67 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  // Receives the available datagrams, up to [receiveBatchSize], with a single
+  // native call and adds them to [datagrams].
+  //
+  // The data of each datagram is copied by the native call straight into a
+  // list of its own, so that [Datagram.data]'s buffer neither exposes the
+  // other datagrams nor keeps the whole batch alive.
+  void _receiveDatagrams(ListQueue<Datagram> datagrams) {
+    final table = _receivedDatagrams;
+    final received = _nativeRecvFrom(table, _receivedSenders);
+    if (received == null) return;
+    final count = table[0];
+    for (int i = 0; i < count; i++) {
+      final entry = 1 + 3 * i;
+      final sender = _sender(
+        i,
+        table[entry + 1],
+        table[entry + 2],
+        received[2 * i + 1] as String?,
+      );
+      datagrams.add(
+        Datagram(received[2 * i] as Uint8List, sender, table[entry]),
+      );
+    }
+  }
+
+  // Returns the sender of the [index]th datagram received, whose address has
+  // type [type] and [scopeId]. [scopedAddress] is its address as a string if
+  // it has a scope id.
+  _InternetAddress _sender(
+    int index,
+    int type,
+    int scopeId,
+    String? scopedAddress,
+  ) {
+    final senders = _receivedSenders;
+    final offset = index * _InternetAddress._IPv6AddrLength;
+    final length = (type == 0)
+        ? _InternetAddress._IPv4AddrLength
+        : _InternetAddress._IPv6AddrLength;
+    final last = _lastSender;
+    if (last != null &&
+        last._in_addr.length == length &&
+        last._scope_id == scopeId) {
+      int i = 0;
+      while (i < length && last._in_addr[i] == senders[offset + i]) {
+        i++;
+      }
+      if (i == length) return last;
+    }
+    final rawAddress = senders.sublist(offset, offset + length);
+    return _lastSender = (scopedAddress == null)
+        ? _InternetAddress.fromRawAddress(rawAddress)
+        : _InternetAddress(
+            InternetAddressType.IPv6,
+            scopedAddress,
+            null,
+            rawAddress,
+            scopeId,
+          );
+  }
+
   SocketMessage? readMessage([int? count]) {
     if (count != null && count <= 0) {
       throw ArgumentError("Illegal length $count");
@@ -1480,6 +1593,81 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  // Keep in sync with SocketBase::kMaxIOVectors in socket_base.h.
+  static const int _maxIOVectors = 64;
+
+  /// Writes [buffers], starting at [offset] in the first one, as if they
+  /// were concatenated, with a single vectored write where the platform
+  /// supports it.
+  ///
+  /// Returns the number of bytes written, like [write].
+  int writeVector(List<List<int>> buffers, int offset) {
+    if (isClosing || isClosed) return 0;
+    final count =
+        buffers.length < _maxIOVectors ? buffers.length : _maxIOVectors;
+    if (count == 0) return 0;
+    try {
+      // Triples <buffer, offset, length> arranged to minimize dart api use in
+      // the native method.
+      final vectors = List<Object>.filled(count * 3, 0);
+      int bytes = 0;
+      for (int i = 0; i < count; i++) {
+        final buffer = buffers[i];
+        final start = (i == 0) ? offset : 0;
+        _BufferAndStart bufferAndStart = _ensureFastAndSerializableByteData(
+          buffer,
+          start,
+          buffer.length,
+        );
+        vectors[i * 3] = bufferAndStart.buffer;
+        vectors[i * 3 + 1] = bufferAndStart.start;
+        vectors[i * 3 + 2] = buffer.length - start;
+        bytes += buffer.length - start;
+      }
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+          _nativeGetSocketId(),
+          _SocketProfileType.writeBytes,
+          bytes,
+        );
+      }
+      int result = _nativeWriteVector(vectors);
+      if (result >= 0) {
+        // See write.
+        writeAvailable = (result == bytes) && !hasPendingWrite();
+      } else {
+        // A forced short write, see write.
+        result = -result;
+        writeAvailable = !hasPendingWrite();
+      }
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
+  /// Sends up to [count] bytes of the file open as [fd], starting at
+  /// [position], without copying them through Dart. Only supported on Linux
+  /// and Android.
+  ///
+  /// Returns the number of bytes sent, which is less than [count] if the
+  /// socket would block or the end of the file was reached.
+  int sendFile(int fd, int position, int count) {
+    if (isClosing || isClosed) return 0;
+    final result = _nativeSendFile(fd, position, count);
+    if (!const bool.fromEnvironment("dart.vm.product")) {
+      _SocketProfile.collectStatistic(
+        _nativeGetSocketId(),
+        _SocketProfileType.writeBytes,
+        result,
+      );
+    }
+    writeAvailable = result == count;
+    return result;
+  }
+
   int send(
     List<int> buffer,
     int offset,
@@ -1567,17 +1755,23 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
-  _NativeSocket? accept() {
+  // Accepts the pending connections, up to [acceptBatchSize], with a single
+  // native call.
+  List<_NativeSocket> accept() {
     // Don't issue accept if we're closing.
-    if (isClosing || isClosed) return null;
+    if (isClosing || isClosed) return const [];
     assert(connections > 0);
     connections--;
     tokens++;
     returnTokens(listeningTokenBatchSize);
-    var socket = _NativeSocket.normal(address);
-    if (_nativeAccept(socket) != true) return null;
-    socket.localPort = localPort;
-    return socket;
+    final ids = _acceptedIds;
+    final count = _nativeAccept(ids);
+    return <_NativeSocket>[
+      for (int i = 0; i < count; i++)
+        _NativeSocket.normal(address)
+          .._nativeSetSocketId(ids[i], typeNormalSocket | typeTcpSocket)
+          ..localPort = localPort,
+    ];
   }
 
   int get port {
@@ -1705,7 +1899,9 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
               }
             } else {
               if (isUdp) {
-                _availableDatagram = _nativeAvailableDatagram();
+                _availableDatagram =
+                    (_pendingDatagrams?.isNotEmpty ?? false) ||
+                    _nativeAvailableDatagram();
               } else {
                 available = _nativeAvailable();
               }
@@ -2032,12 +2228,21 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   external bool _nativeAvailableDatagram();
   @pragma("vm:external-name", "Socket_Read")
   external Uint8List? _nativeRead(int len);
+  @pragma("vm:external-name", "Socket_ReadInto")
+  external int _nativeReadInto(Uint8List buffer, int offset, int bytes);
   @pragma("vm:external-name", "Socket_RecvFrom")
-  external Datagram? _nativeRecvFrom();
+  external List<Object?>? _nativeRecvFrom(
+    Int64List table,
+    Uint8List senders,
+  );
   @pragma("vm:external-name", "Socket_ReceiveMessage")
   external List<dynamic> _nativeReceiveMessage(int len);
   @pragma("vm:external-name", "Socket_WriteList")
   external int _nativeWrite(List<int> buffer, int offset, int bytes);
+  @pragma("vm:external-name", "Socket_WriteVector")
+  external int _nativeWriteVector(List<Object> vectors);
+  @pragma("vm:external-name", "Socket_SendFile")
+  external int _nativeSendFile(int fd, int position, int count);
   @pragma("vm:external-name", "Socket_HasPendingWrite")
   external bool _nativeHasPendingWrite();
   @pragma("vm:external-name", "Socket_SendTo")
@@ -2100,7 +2305,7 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     int ttl,
   );
   @pragma("vm:external-name", "ServerSocket_Accept")
-  external bool _nativeAccept(_NativeSocket socket);
+  external int _nativeAccept(Int64List ids);
   @pragma("vm:external-name", "Socket_GetPort")
   external dynamic _nativeGetPort();
   @pragma("vm:external-name", "Socket_GetRemotePeer")
@@ -2181,17 +2386,19 @@ class _RawServerSocket extends Stream<RawSocket>
     _socket.setHandlers(
       read: zone.bindCallbackGuarded(() {
         while (_socket.connections > 0) {
-          var socket = _socket.accept();
-          if (socket == null) return;
-          if (!const bool.fromEnvironment("dart.vm.product")) {
-            _SocketProfile.collectNewSocket(
-              socket._nativeGetSocketId(),
-              _tcpSocket,
-              socket.address,
-              socket.port,
-            );
+          var sockets = _socket.accept();
+          if (sockets.isEmpty) return;
+          for (var socket in sockets) {
+            if (!const bool.fromEnvironment("dart.vm.product")) {
+              _SocketProfile.collectNewSocket(
+                socket._nativeGetSocketId(),
+                _tcpSocket,
+                socket.address,
+                socket.port,
+              );
+            }
+            controller.add(_RawSocket(socket));
           }
-          controller.add(_RawSocket(socket));
           if (controller.isPaused) return;
         }
       }),
@@ -2249,7 +2456,7 @@ class _RawServerSocket extends Stream<RawSocket>
 }
 
 class _RawSocket extends Stream<RawSocketEvent>
-    implements RawSocket, _RawSocketBase {
+    implements RawSocket, _RawSocketBase, _ReadIntoSocket {
   final _NativeSocket _socket;
   final _controller = StreamController<RawSocketEvent>(sync: true);
   bool _readEventsEnabled = true;
@@ -2392,6 +2599,9 @@ class _RawSocket extends Stream<RawSocketEvent>
     }
   }
 
+  int _readInto(Uint8List buffer, int offset, int length) =>
+      _socket.readInto(buffer, offset, length);
+
   SocketMessage? readMessage([int? count]) {
     return _socket.readMessage(count);
   }
@@ -2585,12 +2795,28 @@ class Socket {
 }
 
 class _SocketStreamConsumer implements StreamConsumer<List<int>> {
+  // While a write is pending, data is queued rather than pausing the stream,
+  // up to this many bytes or buffers. The whole queue is then flushed with a
+  // single vectored write once the socket becomes writable again.
+  static const int _maxQueuedBytes = 64 * 1024;
+  static const int _maxQueuedBuffers = 16;
+
   StreamSubscription? subscription;
   final _Socket socket;
-  int? offset;
-  List<int>? buffer;
+  // Buffers waiting to be written, the first of which has been written up to
+  // [offset].
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0;
+  int queuedBytes = 0;
+  bool writePending = false;
+  bool streamDone = false;
   bool paused = false;
   Completer<Socket>? streamCompleter;
+  // A file being sent with sendfile instead of being read into Dart, and the
+  // range of it still to be sent.
+  _RandomAccessFile? file;
+  int filePosition = 0;
+  int fileEnd = 0;
 
   _SocketStreamConsumer(this.socket);
 
@@ -2598,42 +2824,154 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
     socket._ensureRawSocketSubscription();
     final completer = streamCompleter = Completer<Socket>();
     if (socket._raw != null) {
-      subscription = stream.listen(
-        (data) {
-          assert(!paused);
-          assert(buffer == null);
-          buffer = data;
-          offset = 0;
-          try {
-            write();
-          } catch (e) {
-            buffer = null;
-            offset = 0;
-
-            socket.destroy();
-            stop();
-            done(e);
-          }
-        },
-        onError: (error, [stackTrace]) {
-          socket.destroy();
-          done(error, stackTrace);
-        },
-        onDone: () {
-          // Note: stream only delivers done event if subscription is not paused.
-          // so it is crucial to keep subscription paused while writes are
-          // in flight.
-          assert(buffer == null);
-          done();
-        },
-        cancelOnError: true,
-      );
+      if (_canSendFile(stream)) {
+        sendFile(stream as _FileStream);
+      } else {
+        listen(stream);
+      }
     } else {
       done();
     }
     return completer.future;
   }
 
+  // Streams of whole or partial regular files, as created by File.openRead,
+  // are sent by the kernel directly from the file to the socket.
+  bool _canSendFile(Stream<List<int>> stream) =>
+      (Platform.isLinux || Platform.isAndroid) &&
+      stream is _FileStream &&
+      stream._path != null &&
+      stream._openedFile == null &&
+      socket._raw is _RawSocket;
+
+  Future<void> sendFile(_FileStream stream) async {
+    final path = stream._path!;
+    final completer = streamCompleter;
+    // The socket may be destroyed while the file is being opened, in which
+    // case stop() has already failed the send.
+    bool stopped() =>
+        socket._raw == null || !identical(streamCompleter, completer);
+    _RandomAccessFile? opened;
+    try {
+      final type = await FileSystemEntity.type(path);
+      if (stopped()) {
+        done(const SocketException.closed());
+        return;
+      }
+      if (type != FileSystemEntityType.file) {
+        // sendfile may not support other kinds of files.
+        listen(stream);
+        return;
+      }
+      opened = await File(path).open() as _RandomAccessFile;
+      if (stopped()) {
+        await opened.close();
+        done(const SocketException.closed());
+        return;
+      }
+      final length = await opened.length();
+      if (stopped()) {
+        await opened.close();
+        done(const SocketException.closed());
+        return;
+      }
+      final end = stream._end;
+      fileEnd = (end == null || end > length) ? length : end;
+      filePosition = stream._position < fileEnd ? stream._position : fileEnd;
+      file = opened;
+    } catch (e, st) {
+      await opened?.close();
+      socket.destroy();
+      done(e, st);
+      return;
+    }
+    writeFile();
+  }
+
+  void writeFile() {
+    final opened = file!;
+    int sent;
+    try {
+      sent = socket._sendFile(opened.fd, filePosition, fileEnd - filePosition);
+    } catch (e, st) {
+      socket.destroy();
+      closeFile(e, st);
+      return;
+    }
+    filePosition += sent;
+    if (filePosition >= fileEnd) {
+      closeFile();
+    } else if (sent == 0) {
+      // Either the socket is full or the file was truncated while it was
+      // being sent. Only the latter ends the send early.
+      opened.length().then((length) {
+        if (!identical(file, opened)) return;
+        if (length <= filePosition) {
+          fileEnd = filePosition;
+          closeFile();
+        } else {
+          socket._enableWriteEvent();
+        }
+      }, onError: (e, st) {
+        if (!identical(file, opened)) return;
+        socket.destroy();
+        closeFile(e, st);
+      });
+    } else {
+      socket._enableWriteEvent();
+    }
+  }
+
+  void closeFile([error, stackTrace]) {
+    final opened = file;
+    if (opened == null) return;
+    file = null;
+    opened.close().catchError((_) {}).whenComplete(() {
+      done(error, stackTrace);
+    });
+  }
+
+  void listen(Stream<List<int>> stream) {
+    subscription = stream.listen(
+      (data) {
+        assert(!paused);
+        if (data.isEmpty) return;
+        buffers.add(data);
+        queuedBytes += data.length;
+        try {
+          if (writePending) {
+            pauseIfFull();
+          } else {
+            write();
+          }
+        } catch (e) {
+          buffers.clear();
+          offset = 0;
+          queuedBytes = 0;
+
+          socket.destroy();
+          stop();
+          done(e);
+        }
+      },
+      onError: (error, [stackTrace]) {
+        socket.destroy();
+        done(error, stackTrace);
+      },
+      onDone: () {
+        // Note: stream only delivers done event if subscription is not paused.
+        // so it is crucial to keep subscription paused while the queue is
+        // full. Data that is still queued is written before completing.
+        if (buffers.isEmpty && !writePending) {
+          done();
+        } else {
+          streamDone = true;
+        }
+      },
+      cancelOnError: true,
+    );
+  }
+
   Future<Socket> close() {
     socket._consumerDone();
     return Future.value(socket);
@@ -2651,33 +2989,56 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
   }
 
   void write() {
+    if (file != null) {
+      writeFile();
+      return;
+    }
     final sub = subscription;
     if (sub == null) return;
+    writePending = false;
 
     // We have something to write out.
-    if (offset! < buffer!.length) {
-      offset =
-          offset! + socket._write(buffer!, offset!, buffer!.length - offset!);
+    if (buffers.isNotEmpty) {
+      int written = socket._writeVector(buffers, offset);
+      // Drop the buffers that were written completely.
+      while (buffers.isNotEmpty &&
+          written >= buffers.first.length - offset) {
+        written -= buffers.first.length - offset;
+        queuedBytes -= buffers.first.length;
+        buffers.removeAt(0);
+        offset = 0;
+      }
+      offset += written;
     }
 
-    if (offset! < buffer!.length || !_previousWriteHasCompleted) {
+    if (buffers.isNotEmpty || !_previousWriteHasCompleted) {
       // On Windows we might have written the whole buffer out but we are
-      // still waiting for the write to complete. We should not resume the
-      // subscription until the pending write finishes and we receive a
+      // still waiting for the write to complete. We should not flush the
+      // next buffers until the pending write finishes and we receive a
       // writeEvent signaling that we can write the next chunk or that we
       // can consider all data flushed from our side into kernel buffers.
-      if (!paused) {
-        paused = true;
-        sub.pause();
-      }
+      writePending = true;
+      pauseIfFull();
       socket._enableWriteEvent();
     } else {
       // Write fully completed.
-      buffer = null;
       if (paused) {
         paused = false;
         sub.resume();
       }
+      if (streamDone) {
+        streamDone = false;
+        done();
+      }
+    }
+  }
+
+  void pauseIfFull() {
+    if (!paused &&
+        (queuedBytes >= _maxQueuedBytes ||
+            buffers.length >= _maxQueuedBuffers)) {
+      paused = true;
+      subscription!.pause();
     }
   }
 
@@ -2694,6 +3055,22 @@ class _SocketStreamConsumer implements StreamConsumer<List<int>> {
   }
 
   void stop() {
+    if (file == null && subscription == null) {
+      // A file send that is still opening the file is failed here; it closes
+      // the file itself once it sees that it was stopped.
+      done(const SocketException.closed());
+      return;
+    }
+    final opened = file;
+    if (opened != null) {
+      file = null;
+      opened.close().catchError((_) {});
+      socket._disableWriteEvent();
+      // The rest of the file is not sent, so the send must not complete as a
+      // success.
+      done(const SocketException.closed());
+      return;
+    }
     final sub = subscription;
     if (sub == null) return;
     sub.cancel();
@@ -2848,7 +3225,7 @@ class _Socket extends Stream<Uint8List> implements Socket {
     _detachReady = completer;
     _sink.close();
     return completer.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -2939,6 +3316,33 @@ class _Socket extends Stream<Uint8List> implements Socket {
     return 0;
   }
 
+  int _sendFile(int fd, int position, int count) {
+    final raw = _raw;
+    if (raw is _RawSocket) {
+      return raw._socket.sendFile(fd, position, count);
+    }
+    return 0;
+  }
+
+  int _writeVector(List<List<int>> buffers, int offset) {
+    final raw = _raw;
+    if (raw is _RawSocket) {
+      return raw._socket.writeVector(buffers, offset);
+    }
+    if (raw == null) return 0;
+    // Other raw sockets, such as _RawSecureSocket, are written one buffer at
+    // a time.
+    int written = 0;
+    for (int i = 0; i < buffers.length; i++) {
+      final buffer = buffers[i];
+      final start = (i == 0) ? offset : 0;
+      final bytes = raw.write(buffer, start, buffer.length - start);
+      written += bytes;
+      if (bytes < buffer.length - start) break;
+    }
+    return written;
+  }
+
   void _enableWriteEvent() {
     _raw?.writeEventsEnabled = true;
   }
@@ -3148,21 +3552,6 @@ class _RawDatagramSocket extends Stream<RawSocketEvent>
   void setRawOption(RawSocketOption option) => _socket.setRawOption(option);
 }
 
-@pragma("vm:entry-point", "call")
-Datagram _makeDatagram(
-  Uint8List data,
-  String address,
-  Uint8List in_addr,
-  int port,
-  int type,
-) {
-  return Datagram(
-    data,
-    _InternetAddress(InternetAddressType._from(type), address, null, in_addr),
-    port,
-  );
-}
-
 @patch
 @pragma("vm:entry-point")
 class ResourceHandle {
@@ -65,8 +65,28 @@ class RawReceivePort {
     result.handler = handler;
     return result;
   }
+
+  @patch
+  factory RawReceivePort.bounded(
+    int capacity, {
+    Function? handler,
+    String debugName = '',
+    bool blockSenders = false,
+  }) {
+    RangeError.checkValueInInterval(capacity, 1, _maxPortCapacity, 'capacity');
+    _RawReceivePort result = _RawReceivePort._bounded(
+      debugName,
+      capacity,
+      blockSenders,
+    );
+    result.handler = handler;
+    return result;
+  }
 }
 
+// The largest capacity of a bounded port, which fits in a Smi everywhere.
+const int _maxPortCapacity = (1 << 30) - 1;
+
 final class _ReceivePortImpl extends Stream implements ReceivePort {
   _ReceivePortImpl([String debugName = ''])
     : this.fromRawReceivePort(RawReceivePort(null, debugName));
@@ -146,6 +166,23 @@ final class _RawReceivePort implements RawReceivePort {
   @pragma("vm:external-name", "RawReceivePort_factory")
   external factory _RawReceivePort._(String debugName);
 
+  factory _RawReceivePort._bounded(
+    String debugName,
+    int capacity,
+    bool blockSenders,
+  ) {
+    final port = _RawReceivePort._newBounded(debugName, capacity, blockSenders);
+    _portMap[port._get_id()] = port;
+    return port;
+  }
+
+  @pragma("vm:external-name", "RawReceivePort_factoryBounded")
+  external factory _RawReceivePort._newBounded(
+    String debugName,
+    int capacity,
+    bool blockSenders,
+  );
+
   close() {
     // Close the port and remove it from the handler map.
     _portMap.remove(this._closeInternal());
@@ -146,6 +146,16 @@ abstract class RawReceivePort {
   factory RawReceivePort([Function? handler, String debugName = '']) {
     throw UnsupportedError("RawReceivePort");
   }
+
+  @patch
+  factory RawReceivePort.bounded(
+    int capacity, {
+    Function? handler,
+    String debugName = '',
+    bool blockSenders = false,
+  }) {
+    throw UnsupportedError("RawReceivePort.bounded");
+  }
 }
 
 @patch
@@ -96,6 +96,19 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
   /// will not compute an adler32 check value
   final bool raw;
 
+  /// The number of threads that may compress data at the same time.
+  ///
+  /// When greater than `1`, the input is split into blocks of 128 KiB that are
+  /// compressed in parallel, each using the data preceding it as its
+  /// dictionary. The output is still a single valid stream, but it is slightly
+  /// larger than, and differs from, the output of compression on one thread.
+  /// Parallel compression is not used for zlib streams with a [dictionary].
+  ///
+  /// The calling thread compresses blocks itself rather than wait for the
+  /// other threads, but flushing or ending the stream waits for the blocks
+  /// that are still being compressed. The default value is `1`.
+  final int threads;
+
   /// Initial compression dictionary.
   ///
   /// It should consist of strings (byte sequences) that are likely to be
@@ -114,11 +127,13 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
     this.dictionary,
     this.raw = false,
     this.gzip = false,
+    this.threads = 1,
   }) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   const ZLibCodec._default()
@@ -128,7 +143,8 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
       strategy = ZLibOption.strategyDefault,
       raw = false,
       gzip = false,
-      dictionary = null;
+      dictionary = null,
+      threads = 1;
 
   /// Get a [ZLibEncoder] for encoding to `ZLib` compressed data.
   ZLibEncoder get encoder => ZLibEncoder(
@@ -139,6 +155,7 @@ final class ZLibCodec extends Codec<List<int>, List<int>> {
     strategy: strategy,
     dictionary: dictionary,
     raw: raw,
+    threads: threads,
   );
 
   /// Get a [ZLibDecoder] for decoding `ZLib` compressed data.
@@ -199,6 +216,11 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
   /// will not compute an adler32 check value
   final bool raw;
 
+  /// The number of threads that may compress data at the same time.
+  ///
+  /// See [ZLibCodec.threads]. The default value is `1`.
+  final int threads;
+
   GZipCodec({
     this.level = ZLibOption.defaultLevel,
     this.windowBits = ZLibOption.defaultWindowBits,
@@ -207,11 +229,13 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
     this.dictionary,
     this.raw = false,
     this.gzip = true,
+    this.threads = 1,
   }) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   const GZipCodec._default()
@@ -221,7 +245,8 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
       strategy = ZLibOption.strategyDefault,
       raw = false,
       gzip = true,
-      dictionary = null;
+      dictionary = null,
+      threads = 1;
 
   /// Get a [ZLibEncoder] for encoding to `GZip` compressed data.
   ZLibEncoder get encoder => ZLibEncoder(
@@ -232,6 +257,7 @@ final class GZipCodec extends Codec<List<int>, List<int>> {
     strategy: strategy,
     dictionary: dictionary,
     raw: raw,
+    threads: threads,
   );
 
   /// Get a [ZLibDecoder] for decoding `GZip` compressed data.
@@ -293,6 +319,11 @@ final class ZLibEncoder extends Converter<List<int>, List<int>> {
   /// will not compute an adler32 check value
   final bool raw;
 
+  /// The number of threads that may compress data at the same time.
+  ///
+  /// See [ZLibCodec.threads]. The default value is `1`.
+  final int threads;
+
   ZLibEncoder({
     this.gzip = false,
     this.level = ZLibOption.defaultLevel,
@@ -301,11 +332,13 @@ final class ZLibEncoder extends Converter<List<int>, List<int>> {
     this.strategy = ZLibOption.strategyDefault,
     this.dictionary,
     this.raw = false,
+    this.threads = 1,
   }) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   /// Convert a list of bytes using the options given to the ZLibEncoder
@@ -337,6 +370,7 @@ final class ZLibEncoder extends Converter<List<int>, List<int>> {
       strategy,
       dictionary,
       raw,
+      threads,
     );
   }
 }
@@ -402,6 +436,8 @@ final class ZLibDecoder extends Converter<List<int>, List<int>> {
 abstract interface class RawZLibFilter {
   /// Returns a [RawZLibFilter] whose [process] and [processed] methods
   /// compress data.
+  ///
+  /// The [threads] parameter is described by [ZLibCodec.threads].
   factory RawZLibFilter.deflateFilter({
     bool gzip = false,
     int level = ZLibOption.defaultLevel,
@@ -410,7 +446,9 @@ abstract interface class RawZLibFilter {
     int strategy = ZLibOption.strategyDefault,
     List<int>? dictionary,
     bool raw = false,
+    int threads = 1,
   }) {
+    _validateZLibThreads(threads);
     return _makeZLibDeflateFilter(
       gzip,
       level,
@@ -419,6 +457,7 @@ abstract interface class RawZLibFilter {
       strategy,
       dictionary,
       raw,
+      threads,
     );
   }
 
@@ -457,6 +496,7 @@ abstract interface class RawZLibFilter {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   );
 
   external static RawZLibFilter _makeZLibInflateFilter(
@@ -498,6 +538,7 @@ class _ZLibEncoderSink extends _FilterSink {
     int strategy,
     List<int>? dictionary,
     bool raw,
+    int threads,
   ) : super(
         sink,
         RawZLibFilter._makeZLibDeflateFilter(
@@ -508,6 +549,7 @@ class _ZLibEncoderSink extends _FilterSink {
           strategy,
           dictionary,
           raw,
+          threads,
         ),
       );
 }
@@ -614,6 +656,12 @@ void _validateZLibMemLevel(int memLevel) {
   }
 }
 
+void _validateZLibThreads(int threads) {
+  if (threads < 1) {
+    throw RangeError.range(threads, 1, null, "threads");
+  }
+}
+
 void _validateZLibStrategy(int strategy) {
   const strategies = <int>[
     ZLibOption.strategyFiltered,
@@ -251,15 +251,15 @@ class _Directory extends FileSystemEntity implements Directory {
     bool recursive = false,
     bool followLinks = true,
   }) {
-    return _AsyncDirectoryLister(
-      // FIXME(bkonyi): here we're using `path` directly, which might cause issues
-      // if it is not UTF-8 encoded.
-      FileSystemEntity._toUtf8Array(
-        FileSystemEntity._ensureTrailingPathSeparators(path),
-      ),
-      recursive,
-      followLinks,
-    ).stream;
+    // FIXME(bkonyi): here we're using `path` directly, which might cause issues
+    // if it is not UTF-8 encoded.
+    final rawPath = FileSystemEntity._toUtf8Array(
+      FileSystemEntity._ensureTrailingPathSeparators(path),
+    );
+    if (recursive && !followLinks) {
+      return _ParallelAsyncDirectoryLister(rawPath).stream;
+    }
+    return _AsyncDirectoryLister(rawPath, recursive, followLinks).stream;
   }
 
   List<FileSystemEntity> listSync({
@@ -305,6 +305,7 @@ class _AsyncDirectoryLister {
   static const int listLink = 2;
   static const int listError = 3;
   static const int listDone = 4;
+  static const int listBatch = 5;
 
   static const int responseType = 0;
   static const int responsePath = 1;
@@ -408,6 +409,9 @@ class _AsyncDirectoryLister {
             case listLink:
               controller.add(Link.fromRawPath(result[i]));
               break;
+            case listBatch:
+              addBatch(result[i] as Uint8List);
+              break;
             case listError:
               error(result[i]);
               break;
@@ -422,6 +426,34 @@ class _AsyncDirectoryLister {
     });
   }
 
+  // Adds the entries packed by the native lister, each a type byte, a 32-bit
+  // little-endian length and the path.
+  void addBatch(Uint8List batch) {
+    int offset = 0;
+    while (offset < batch.length) {
+      final type = batch[offset];
+      final length =
+          batch[offset + 1] |
+          (batch[offset + 2] << 8) |
+          (batch[offset + 3] << 16) |
+          (batch[offset + 4] << 24);
+      offset += 5;
+      final rawPath = Uint8List.sublistView(batch, offset, offset + length);
+      offset += length;
+      switch (type) {
+        case listFile:
+          controller.add(File.fromRawPath(rawPath));
+          break;
+        case listDirectory:
+          controller.add(Directory.fromRawPath(rawPath));
+          break;
+        case listLink:
+          controller.add(Link.fromRawPath(rawPath));
+          break;
+      }
+    }
+  }
+
   void _cleanup() {
     controller.close();
     closeCompleter.complete();
@@ -475,3 +507,90 @@ class _AsyncDirectoryLister {
     }
   }
 }
+
+/// Lists a directory tree by listing each of its directories separately, so
+/// that the IO service reads several directories at the same time.
+///
+/// Only used when links are not followed, as the native recursive lister
+/// keeps track of the links followed to reach a directory to detect loops.
+class _ParallelAsyncDirectoryLister {
+  static const int maxActiveListings = 8;
+
+  final controller = StreamController<FileSystemEntity>(sync: true);
+  final pending = ListQueue<Uint8List>();
+  final active = <StreamSubscription<FileSystemEntity>>{};
+  bool canceled = false;
+
+  _ParallelAsyncDirectoryLister(Uint8List rawPath) {
+    pending.add(rawPath);
+    controller
+      ..onListen = startListings
+      ..onPause = onPause
+      ..onResume = onResume
+      ..onCancel = onCancel;
+  }
+
+  Stream<FileSystemEntity> get stream => controller.stream;
+
+  void startListings() {
+    while (!canceled &&
+        pending.isNotEmpty &&
+        active.length < maxActiveListings) {
+      final lister = _AsyncDirectoryLister(pending.removeFirst(), false, false);
+      late final StreamSubscription<FileSystemEntity> subscription;
+      subscription = lister.stream.listen(
+        (entity) {
+          if (entity is _Directory) {
+            pending.add(childPath(entity._rawPath));
+            startListings();
+          }
+          controller.add(entity);
+        },
+        onError: controller.addError,
+        onDone: () {
+          active.remove(subscription);
+          if (active.isEmpty && pending.isEmpty) {
+            controller.close();
+          } else {
+            startListings();
+          }
+        },
+      );
+      active.add(subscription);
+      if (controller.isPaused) {
+        subscription.pause();
+      }
+    }
+  }
+
+  void onPause() {
+    for (final subscription in active) {
+      subscription.pause();
+    }
+  }
+
+  void onResume() {
+    for (final subscription in active) {
+      subscription.resume();
+    }
+  }
+
+  Future onCancel() {
+    canceled = true;
+    pending.clear();
+    return Future.wait([
+      for (final subscription in active) subscription.cancel(),
+    ]);
+  }
+
+  // The raw path of a directory, as expected by the native lister: with a
+  // trailing separator and null terminated.
+  static Uint8List childPath(Uint8List rawPath) {
+    int length = rawPath.length;
+    if (length > 0 && rawPath[length - 1] == 0) length--;
+    final result = Uint8List(length + 2);
+    result.setRange(0, length, rawPath);
+    result[length] = Platform.pathSeparator.codeUnitAt(0);
+    return result;
+  }
+}
@@ -538,6 +538,15 @@ abstract interface class _RawSocketBase {
   void set _owner(owner);
 }
 
+/// A socket that can read directly into a buffer, without allocating and
+/// copying a new list for every read.
+abstract interface class _ReadIntoSocket {
+  /// Reads up to [length] available bytes into [buffer] at [offset].
+  ///
+  /// Returns the number of bytes read.
+  int _readInto(Uint8List buffer, int offset, int length);
+}
+
 class _RawSecureSocket extends Stream<RawSocketEvent>
     implements RawSecureSocket, _RawSocketBase {
   // Status states
@@ -589,7 +598,7 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   bool _filterPending = false;
   bool _filterActive = false;
 
-  _SecureFilter? _secureFilter = _SecureFilter._();
+  _SecureFilter? _secureFilter;
   String? _selectedProtocol;
 
   static Future<_RawSecureSocket> connect(
@@ -654,7 +663,7 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
       ..onCancel = _onSubscriptionStateChange;
     // Throw an ArgumentError if any field is invalid.  After this, all
     // errors will be reported through the future or the stream.
-    final secureFilter = _secureFilter!;
+    final secureFilter = _secureFilter = _SecureFilter._(context.bufferSize);
     secureFilter.init();
     secureFilter.registerHandshakeCompleteCallback(
       _secureHandshakeCompleteHandler,
@@ -1170,7 +1179,14 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   void _readSocket() {
     if (_status == closedStatus) return;
     var buffer = _secureFilter!.buffers![readEncryptedId];
-    if (buffer.writeFromSource(_readSocketOrBufferedData) > 0) {
+    var socket = _socket;
+    var bytesRead =
+        (socket is _ReadIntoSocket &&
+                _bufferedData == null &&
+                !_socketClosedRead)
+            ? buffer.writeFromSocket(socket)
+            : buffer.writeFromSource(_readSocketOrBufferedData);
+    if (bytesRead > 0) {
       _filterStatus.readEmpty = false;
     } else {
       _socket.readEventsEnabled = false;
@@ -1412,6 +1428,20 @@ class _ExternalBuffer {
     return written;
   }
 
+  int writeFromSocket(_ReadIntoSocket socket) {
+    int written = 0;
+    int toWrite = linearFree;
+    // Loop over zero, one, or two linear data ranges.
+    while (toWrite > 0) {
+      int bytes = socket._readInto(data as Uint8List, end, toWrite);
+      if (bytes == 0) break;
+      advanceEnd(bytes);
+      written += bytes;
+      toWrite = linearFree;
+    }
+    return written;
+  }
+
   bool readToSocket(RawSocket socket) {
     // Loop over zero, one, or two linear data ranges.
     while (true) {
@@ -1428,7 +1458,7 @@ class _ExternalBuffer {
 }
 
 abstract class _SecureFilter {
-  external factory _SecureFilter._();
+  external factory _SecureFilter._(int bufferSize);
 
   void connect(
     String hostName,
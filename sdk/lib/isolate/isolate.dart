@@ -999,6 +999,34 @@ abstract interface class RawReceivePort {
   /// this port that can be displayed in tooling.
   external factory RawReceivePort([Function? handler, String debugName = '']);
 
+  /// Opens a long-lived port which holds at most [capacity] messages
+  /// waiting to be handled.
+  ///
+  /// Sending a message with [SendPort.send] to a port which already holds
+  /// [capacity] waiting messages does not grow its queue. If [blockSenders]
+  /// is `true`, the sending isolate waits until the port has room for the
+  /// message. Otherwise, and when the sender is the isolate owning the
+  /// port, [SendPort.send] throws a [StateError] and the message is not
+  /// sent. Messages sent by other means, such as from native code, are
+  /// always delivered.
+  ///
+  /// A blocked sender does not handle any messages or events while it waits,
+  /// but it can still be killed or interrupted. It polls the port for room,
+  /// sleeping up to a millisecond between attempts, so it may resume up to a
+  /// millisecond after the port has room. Two isolates that each block on
+  /// sending to a full port of the other wait forever, as neither handles
+  /// the messages that would make room.
+  ///
+  /// The [capacity] must be positive.
+  ///
+  /// The [handler] and [debugName] are used as for [RawReceivePort.new].
+  external factory RawReceivePort.bounded(
+    int capacity, {
+    Function? handler,
+    String debugName = '',
+    bool blockSenders = false,
+  });
+
   /// Sets the handler that is invoked for every incoming message.
   ///
   /// The handler is invoked in the [Zone.root] zone.
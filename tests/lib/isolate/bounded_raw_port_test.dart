@@ -0,0 +1,65 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test RawReceivePort.bounded.
+
+import 'dart:async';
+import 'dart:isolate';
+
+import 'package:expect/async_helper.dart';
+import 'package:expect/expect.dart';
+
+const messageCount = 1000;
+
+void sendMany(SendPort port) {
+  for (int i = 0; i < messageCount; i++) {
+    port.send(i);
+  }
+}
+
+Future<void> testRejectsWhenFull() async {
+  final received = <int>[];
+  final port = RawReceivePort.bounded(2, handler: received.add);
+  port.sendPort.send(0);
+  port.sendPort.send(1);
+  Expect.throws<StateError>(() => port.sendPort.send(2));
+
+  // Handling the messages makes room again.
+  await Future.delayed(Duration.zero);
+  Expect.listEquals([0, 1], received);
+  port.sendPort.send(3);
+  await Future.delayed(Duration.zero);
+  Expect.listEquals([0, 1, 3], received);
+  port.close();
+}
+
+Future<void> testSenderWaitsForRoom() async {
+  final completer = Completer<void>();
+  final received = <int>[];
+  final port = RawReceivePort.bounded(
+    1,
+    handler: (int message) {
+      received.add(message);
+      if (received.length == messageCount) completer.complete();
+    },
+    blockSenders: true,
+  );
+  await Isolate.spawn(sendMany, port.sendPort);
+  await completer.future;
+  Expect.listEquals(List.generate(messageCount, (i) => i), received);
+
+  // The isolate owning the port cannot wait for itself to make room.
+  port.sendPort.send(0);
+  Expect.throws<StateError>(() => port.sendPort.send(1));
+  port.close();
+}
+
+main() {
+  Expect.throws<RangeError>(() => RawReceivePort.bounded(0));
+
+  asyncTest(() async {
+    await testRejectsWhenFull();
+    await testSenderWaitsForRoom();
+  });
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=
+// VMOptions=--isolate_spawn_pool_size=1
+// VMOptions=--isolate_spawn_pool_size=4
+
+// Test that isolates spawned from a pool of pre-created isolates start with
+// fresh statics and get the requested debug names. That spawns take isolates
+// from the pool is tested in pkg/vm_service/test/isolate_spawn_pool_test.dart.
+
+import 'dart:isolate';
+
+import 'package:expect/async_helper.dart';
+import 'package:expect/expect.dart';
+
+int counter = 0;
+final List<int> values = <int>[];
+
+int bump(int value) {
+  counter++;
+  values.add(value);
+  return counter * 1000 + values.length * 100 + value;
+}
+
+void reportName(SendPort port) {
+  port.send(Isolate.current.debugName);
+}
+
+Future<void> main() async {
+  asyncStart();
+
+  counter = 42;
+  values.add(42);
+
+  for (int i = 0; i < 20; i++) {
+    Expect.equals(1100 + i, await Isolate.run(() => bump(i)));
+  }
+  final results = await Future.wait([
+    for (int i = 0; i < 20; i++) Isolate.run(() => bump(i)),
+  ]);
+  for (int i = 0; i < 20; i++) {
+    Expect.equals(1100 + i, results[i]);
+  }
+  Expect.equals(42, counter);
+  Expect.listEquals([42], values);
+
+  for (int i = 0; i < 5; i++) {
+    final port = ReceivePort();
+    await Isolate.spawn(reportName, port.sendPort, debugName: 'worker$i');
+    Expect.equals('worker$i', await port.first);
+  }
+
+  asyncEnd();
+}
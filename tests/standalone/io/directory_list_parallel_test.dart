@@ -0,0 +1,89 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that large directory trees are listed completely, both by recursive
+// listings that walk subdirectories in parallel (when links are not followed)
+// and by those that do not, and that such listings can be canceled.
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const directoryCount = 20;
+const filesPerDirectory = 300;
+
+Set<String> describe(Iterable<FileSystemEntity> entities) => {
+  for (final entity in entities) '${entity.runtimeType}:${entity.path}',
+};
+
+Future<void> main() async {
+  asyncStart();
+
+  final temp = await Directory.systemTemp.createTemp('directory_list_parallel');
+  try {
+    for (int i = 0; i < directoryCount; i++) {
+      final nested = Directory('${temp.path}/dir$i/nested');
+      nested.createSync(recursive: true);
+      for (int j = 0; j < filesPerDirectory; j++) {
+        File('${nested.parent.path}/file_with_a_longer_name_$j').createSync();
+      }
+      File('${nested.path}/file').createSync();
+      Link('${nested.path}/link').createSync('${nested.path}/file');
+    }
+
+    final expected = describe(
+      temp.listSync(recursive: true, followLinks: false),
+    );
+    Expect.equals(directoryCount * (filesPerDirectory + 4), expected.length);
+
+    Expect.setEquals(
+      expected,
+      describe(await temp.list(recursive: true, followLinks: false).toList()),
+    );
+    Expect.setEquals(
+      describe(temp.listSync()),
+      describe(await temp.list().toList()),
+    );
+
+    final followed = await temp.list(recursive: true).toList();
+    Expect.setEquals(
+      describe(temp.listSync(recursive: true)),
+      describe(followed),
+    );
+
+    // Directories are reported before their contents.
+    final seen = <String>{temp.path};
+    await for (final entity in temp.list(recursive: true, followLinks: false)) {
+      Expect.isTrue(seen.contains(entity.parent.path));
+      if (entity is Directory) seen.add(entity.path);
+    }
+
+    // Cancel listings while they are paused and while they are running.
+    final completer = Completer<void>();
+    late StreamSubscription<FileSystemEntity> subscription;
+    int count = 0;
+    subscription = temp.list(recursive: true, followLinks: false).listen((_) {
+      if (++count == 10) {
+        subscription.pause();
+        Timer(const Duration(milliseconds: 10), () {
+          subscription.cancel().then((_) => completer.complete());
+        });
+      }
+    });
+    await completer.future;
+    await temp.list(recursive: true, followLinks: false).first;
+
+    await asyncExpectThrows<FileSystemException>(
+      Directory(
+        '${temp.path}/missing',
+      ).list(recursive: true, followLinks: false).toList(),
+    );
+  } finally {
+    await temp.delete(recursive: true);
+  }
+
+  asyncEnd();
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--event-handler-threads=4
+//
+// Tests that sockets and timers spread over several event handler threads
+// deliver all their events. Timers are routed by their isolate's port, so
+// several isolates are used to give them different threads.
+
+import "dart:async";
+import "dart:io";
+import "dart:isolate";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const isolateCount = 4;
+const connectionCount = 8;
+const timerCount = 8;
+const messageSize = 100 * 1024;
+
+Future<int> echo(int port, int index) async {
+  final socket = await Socket.connect(InternetAddress.loopbackIPv4, port);
+  socket.add(List<int>.filled(messageSize, index & 0xFF));
+  await socket.close();
+  int received = 0;
+  await for (final data in socket) {
+    for (final byte in data) {
+      Expect.equals(index & 0xFF, byte);
+    }
+    received += data.length;
+  }
+  return received;
+}
+
+// Echoes through [connectionCount] connections to the server on [port] while
+// [timerCount] timers run, in the current isolate.
+Future<void> run(int port) async {
+  int fired = 0;
+  final timers = <Future<void>>[
+    for (int i = 0; i < timerCount; i++)
+      Future.delayed(Duration(milliseconds: i), () => fired++),
+  ];
+  final results = await Future.wait([
+    for (int i = 0; i < connectionCount; i++) echo(port, i),
+  ]);
+  for (final received in results) {
+    Expect.equals(messageSize, received);
+  }
+  await Future.wait(timers);
+  Expect.equals(timerCount, fired);
+
+  // A periodic timer keeps being rescheduled on its handler.
+  int ticks = 0;
+  final ticked = Completer<void>();
+  Timer.periodic(const Duration(milliseconds: 1), (timer) {
+    if (++ticks == 5) {
+      timer.cancel();
+      ticked.complete();
+    }
+  });
+  await ticked.future;
+}
+
+Future<void> main() async {
+  asyncStart();
+
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((Socket client) {
+    client.addStream(client).then((_) => client.close());
+  });
+
+  final port = server.port;
+  await Future.wait([
+    run(port),
+    for (int i = 0; i < isolateCount; i++) Isolate.run(() => run(port)),
+  ]);
+  await server.close();
+
+  asyncEnd();
+}
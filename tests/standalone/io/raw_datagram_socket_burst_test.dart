@@ -0,0 +1,55 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that datagrams queued on a socket before it is read, which are
+// received in batches where supported, are all delivered in order with their
+// sender, each in a buffer of its own.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future<void> main() async {
+  asyncStart();
+
+  const datagramCount = 32;
+  final receiver = await RawDatagramSocket.bind(
+    InternetAddress.loopbackIPv4,
+    0,
+  );
+  final sender = await RawDatagramSocket.bind(InternetAddress.loopbackIPv4, 0);
+  receiver.readEventsEnabled = false;
+  for (int i = 0; i < datagramCount; i++) {
+    // Vary the sizes, staying within the default receive buffer.
+    final data = Uint8List(1 + (i * 397) % 3000)..fillRange(0, 1, i);
+    Expect.equals(
+      data.length,
+      sender.send(data, InternetAddress.loopbackIPv4, receiver.port),
+    );
+  }
+
+  int received = 0;
+  receiver.readEventsEnabled = true;
+  await for (final event in receiver) {
+    if (event != RawSocketEvent.read) continue;
+    Datagram? datagram;
+    while ((datagram = receiver.receive()) != null) {
+      Expect.equals(1 + (received * 397) % 3000, datagram!.data.length);
+      // The data does not share a buffer with the rest of the batch.
+      Expect.equals(0, datagram.data.offsetInBytes);
+      Expect.equals(datagram.data.length, datagram.data.buffer.lengthInBytes);
+      Expect.equals(received, datagram.data[0]);
+      Expect.equals(InternetAddress.loopbackIPv4, datagram.address);
+      Expect.equals(sender.port, datagram.port);
+      received++;
+    }
+    if (received == datagramCount) break;
+  }
+
+  sender.close();
+  receiver.close();
+  asyncEnd();
+}
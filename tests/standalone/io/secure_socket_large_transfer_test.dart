@@ -0,0 +1,90 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+// OtherResources=certificates/server_chain.pem
+// OtherResources=certificates/server_key.pem
+// OtherResources=certificates/trusted_certs.pem
+//
+// Tests that large amounts of data, spanning many full TLS records, are
+// echoed intact over a secure socket in both directions, with the default
+// and with larger buffer sizes.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+String localFile(path) => Platform.script.resolve(path).toFilePath();
+
+SecurityContext serverContext() => new SecurityContext()
+  ..useCertificateChain(localFile('certificates/server_chain.pem'))
+  ..usePrivateKey(
+    localFile('certificates/server_key.pem'),
+    password: 'dartdart',
+  );
+
+SecurityContext clientContext() => new SecurityContext()
+  ..setTrustedCertificates(localFile('certificates/trusted_certs.pem'));
+
+Future<void> echo(
+  Uint8List data,
+  SecurityContext serverContext,
+  SecurityContext clientContext,
+) async {
+  final server = await SecureServerSocket.bind(
+    InternetAddress.loopbackIPv4,
+    0,
+    serverContext,
+  );
+  server.listen((SecureSocket client) {
+    client.addStream(client).then((_) => client.close());
+  });
+
+  final socket = await SecureSocket.connect(
+    "localhost",
+    server.port,
+    context: clientContext,
+  );
+  // Send in uneven chunks so records and buffers do not line up.
+  for (int offset = 0; offset < data.length; offset += 7777) {
+    final end = offset + 7777 < data.length ? offset + 7777 : data.length;
+    socket.add(Uint8List.sublistView(data, offset, end));
+  }
+  await socket.close();
+  final received = BytesBuilder();
+  await for (final chunk in socket) {
+    received.add(chunk);
+  }
+  Expect.listEquals(data, received.takeBytes());
+  await server.close();
+}
+
+Future<void> main() async {
+  asyncStart();
+
+  final data = Uint8List(4 * 1024 * 1024 + 123);
+  for (int i = 0; i < data.length; i++) {
+    data[i] = (i * 17) & 0xFF;
+  }
+
+  Expect.equals(8192, clientContext().bufferSize);
+  Expect.throwsRangeError(() => clientContext().bufferSize = 1023);
+  Expect.throwsRangeError(() => clientContext().bufferSize = 1024 * 1024);
+
+  await echo(data, serverContext(), clientContext());
+  await echo(
+    data,
+    serverContext()..bufferSize = 16 * 1024,
+    clientContext()..bufferSize = 16 * 1024,
+  );
+  // The two ends do not need to agree.
+  await echo(data, serverContext()..bufferSize = 1024, clientContext());
+
+  asyncEnd();
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that a burst of connections, which are accepted in batches where
+// supported, is delivered completely, including while the server is paused.
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future<void> main() async {
+  asyncStart();
+
+  const connectionCount = 100;
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final accepted = <Socket>[];
+  late StreamSubscription<Socket> subscription;
+  subscription = server.listen((Socket socket) {
+    accepted.add(socket);
+    socket.write('${accepted.length}');
+    socket.close();
+    if (accepted.length == connectionCount ~/ 2) {
+      subscription.pause(Future.delayed(const Duration(milliseconds: 50)));
+    }
+  });
+
+  final replies = await Future.wait([
+    for (int i = 0; i < connectionCount; i++)
+      Socket.connect(InternetAddress.loopbackIPv4, server.port).then(
+        (socket) => socket.fold<List<int>>([], (a, b) => a..addAll(b)),
+      ),
+  ]);
+  Expect.equals(connectionCount, accepted.length);
+  final ids = replies.map((reply) => int.parse(String.fromCharCodes(reply)));
+  Expect.setEquals({for (int i = 1; i <= connectionCount; i++) i}, ids.toSet());
+
+  await server.close();
+  asyncEnd();
+}
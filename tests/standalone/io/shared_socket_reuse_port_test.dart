@@ -0,0 +1,90 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--reuse-port-for-shared-sockets
+// VMOptions=--reuse-port-for-shared-sockets --event-handler-threads=2
+//
+// Tests that server sockets bound with `shared: true` in several isolates
+// all accept connections, and keep doing so when one of them is closed.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+
+import 'package:expect/async_helper.dart';
+import 'package:expect/expect.dart';
+
+const workerCount = 4;
+const connectionCount = 64;
+
+Future<void> worker(List args) async {
+  final id = args[0] as int;
+  final port = args[1] as int;
+  final replyPort = args[2] as SendPort;
+  final server = await ServerSocket.bind(
+    InternetAddress.loopbackIPv4,
+    port,
+    shared: true,
+  );
+  final stop = ReceivePort();
+  stop.listen((_) async {
+    await server.close();
+    stop.close();
+  });
+  server.listen((Socket client) {
+    client.write('$id');
+    client.close();
+  });
+  replyPort.send(stop.sendPort);
+}
+
+Future<String> request(int port) async {
+  final socket = await Socket.connect(InternetAddress.loopbackIPv4, port);
+  final reply = await socket.fold<List<int>>([], (a, b) => a..addAll(b));
+  socket.destroy();
+  return String.fromCharCodes(reply);
+}
+
+Future<void> main() async {
+  asyncStart();
+
+  // Bind first to obtain a free port, and close it once the workers listen.
+  final first = await ServerSocket.bind(
+    InternetAddress.loopbackIPv4,
+    0,
+    shared: true,
+  );
+  final port = first.port;
+
+  final ready = ReceivePort();
+  final stopPorts = <SendPort>[];
+  final readyDone = ready.take(workerCount).forEach((stopPort) {
+    stopPorts.add(stopPort as SendPort);
+  });
+  for (int i = 0; i < workerCount; i++) {
+    await Isolate.spawn(worker, [i, port, ready.sendPort]);
+  }
+  await readyDone;
+  await first.close();
+
+  Future<void> check() async {
+    final replies = await Future.wait([
+      for (int i = 0; i < connectionCount; i++) request(port),
+    ]);
+    for (final reply in replies) {
+      Expect.isTrue(int.parse(reply) < workerCount);
+    }
+  }
+
+  await check();
+  stopPorts.removeLast().send(null);
+  await Future.delayed(const Duration(milliseconds: 100));
+  await check();
+
+  for (final stopPort in stopPorts) {
+    stopPort.send(null);
+  }
+  asyncEnd();
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that file streams added to a socket, which are sent directly from the
+// file where supported, arrive intact, including partial ranges, and that
+// destroying the socket fails a send that has not finished.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future<List<int>> transfer(Stream<List<int>> Function() openRead) async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((Socket client) async {
+    await client.addStream(openRead());
+    client.add([1, 2, 3]);
+    await client.close();
+  });
+  final socket = await Socket.connect(server.address, server.port);
+  final received = BytesBuilder();
+  await for (final data in socket) {
+    received.add(data);
+  }
+  socket.destroy();
+  await server.close();
+  return received.takeBytes();
+}
+
+// Destroys the sending socket while the peer is not reading, so that the file
+// cannot have been sent completely. With [immediately] the socket is destroyed
+// before the file has even been opened.
+Future<Object?> destroyWhileSending(
+  File file, {
+  bool immediately = false,
+}) async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  final sent = Completer<Object?>();
+  server.listen((Socket client) {
+    client
+        .addStream(file.openRead())
+        .then((_) => sent.complete(null), onError: sent.complete);
+    if (immediately) {
+      client.destroy();
+    } else {
+      Timer(const Duration(milliseconds: 100), client.destroy);
+    }
+  });
+  final socket = await Socket.connect(server.address, server.port);
+  final error = await sent.future;
+  socket.destroy();
+  await server.close();
+  return error;
+}
+
+Future<void> main() async {
+  asyncStart();
+
+  final temp = await Directory.systemTemp.createTemp('socket_add_file');
+  try {
+    final data = Uint8List(3 * 1024 * 1024 + 17);
+    for (int i = 0; i < data.length; i++) {
+      data[i] = (i * 31) & 0xFF;
+    }
+    final file = File('${temp.path}/data');
+    await file.writeAsBytes(data);
+
+    Expect.listEquals(
+      [...data, 1, 2, 3],
+      await transfer(() => file.openRead()),
+    );
+    Expect.listEquals(
+      [...data.sublist(1000, 2000000), 1, 2, 3],
+      await transfer(() => file.openRead(1000, 2000000)),
+    );
+    Expect.listEquals(
+      [...data.sublist(data.length - 10), 1, 2, 3],
+      await transfer(() => file.openRead(data.length - 10)),
+    );
+    Expect.listEquals([1, 2, 3], await transfer(() => file.openRead(0, 0)));
+
+    if (Platform.isLinux || Platform.isAndroid) {
+      final large = File('${temp.path}/large');
+      await large.writeAsBytes(Uint8List(64 * 1024 * 1024));
+      Expect.type<SocketException>(await destroyWhileSending(large));
+      Expect.type<SocketException>(
+        await destroyWhileSending(large, immediately: true),
+      );
+    }
+  } finally {
+    await temp.delete(recursive: true);
+  }
+
+  asyncEnd();
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests that many small and large chunks added to a socket while it is not
+// writable are queued, flushed together and arrive intact and in order.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+List<int> chunk(int index) {
+  // Mix small and large chunks, and plain lists with typed data.
+  final length = (index % 7 == 0) ? 64 * 1024 + index : index % 100 + 1;
+  final data = Uint8List(length);
+  for (int i = 0; i < length; i++) {
+    data[i] = (index + i) & 0xFF;
+  }
+  return (index % 3 == 0) ? data.toList() : data;
+}
+
+Future<void> main() async {
+  asyncStart();
+
+  const chunkCount = 500;
+  final expected = BytesBuilder();
+  for (int i = 0; i < chunkCount; i++) {
+    expected.add(chunk(i));
+  }
+
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((Socket client) {
+    for (int i = 0; i < chunkCount; i++) {
+      client.add(chunk(i));
+    }
+    client.close();
+  });
+
+  final socket = await Socket.connect(server.address, server.port);
+  // Let the sender fill the socket buffers before reading.
+  await Future.delayed(const Duration(milliseconds: 100));
+  final received = BytesBuilder();
+  await for (final data in socket) {
+    received.add(data);
+  }
+  Expect.listEquals(expected.takeBytes(), received.takeBytes());
+
+  socket.destroy();
+  await server.close();
+
+  asyncEnd();
+}
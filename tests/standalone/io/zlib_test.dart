@@ -4,6 +4,7 @@
 
 import 'dart:async';
 import 'dart:io';
+import 'dart:math';
 import 'dart:typed_data';
 
 import "package:expect/async_helper.dart";
@@ -276,6 +277,85 @@ void testRoundTripLarge() {
   }
 }
 
+void testRoundTripLargeParallel() {
+  final random = Random(0);
+  final uncompressedData = Uint8List(3000000);
+  for (var i = 0; i < uncompressedData.length; i++) {
+    uncompressedData[i] = (i % 251) ^ (random.nextInt(16) == 0 ? i >> 8 : 0);
+  }
+  for (var threads in [2, 4]) {
+    for (var gzip in [true, false]) {
+      final compressedData = ZLibEncoder(
+        gzip: gzip,
+        threads: threads,
+      ).convert(uncompressedData);
+      final decodedData = ZLibDecoder(gzip: gzip).convert(compressedData);
+      Expect.listEquals(uncompressedData, decodedData);
+    }
+    final compressedData = ZLibEncoder(
+      raw: true,
+      threads: threads,
+    ).convert(uncompressedData);
+    final decodedData = ZLibDecoder(raw: true).convert(compressedData);
+    Expect.listEquals(uncompressedData, decodedData);
+    Expect.listEquals(
+      <int>[],
+      gzip.decode(GZipCodec(threads: threads).encode(<int>[])),
+    );
+  }
+}
+
+void testParallelMatchesSerial() {
+  // Input that fits in one block is compressed exactly as on one thread,
+  // header and trailer included, for every combination of gzip and raw.
+  for (final length in [0, 1000, 100000]) {
+    final data = List.generate(length, (i) => (i * 7) % 13 ^ (i >> 9) & 0xff);
+    for (final gzip in [true, false]) {
+      for (final raw in [true, false]) {
+        final serial = ZLibEncoder(gzip: gzip, raw: raw).convert(data);
+        final parallel = ZLibEncoder(
+          gzip: gzip,
+          raw: raw,
+          threads: 4,
+        ).convert(data);
+        Expect.listEquals(serial, parallel, 'gzip: $gzip, raw: $raw');
+        Expect.listEquals(
+          data,
+          ZLibDecoder(gzip: gzip, raw: raw).convert(parallel),
+        );
+      }
+    }
+  }
+}
+
+void testParallelFlush() {
+  // Everything processed before a flush can be decoded right away.
+  final filter = RawZLibFilter.deflateFilter(gzip: true, threads: 4);
+  final inflate = RawZLibFilter.inflateFilter(gzip: true);
+  final expected = <int>[];
+  final decoded = <int>[];
+  for (var i = 0; i < 10; i++) {
+    final data = List.generate(50000 * i, (j) => (i + j) % 256);
+    expected.addAll(data);
+    filter.process(data, 0, data.length);
+    List<int>? out;
+    while ((out = filter.processed()) != null) {
+      inflate.process(out!, 0, out.length);
+      List<int>? plain;
+      while ((plain = inflate.processed()) != null) {
+        decoded.addAll(plain!);
+      }
+    }
+    Expect.listEquals(expected, decoded);
+  }
+}
+
+void testParallelInvalidThreads() {
+  Expect.throwsRangeError(() => ZLibEncoder(threads: 0));
+  Expect.throwsRangeError(() => GZipCodec(threads: -1));
+  Expect.throwsRangeError(() => RawZLibFilter.deflateFilter(threads: 0));
+}
+
 void testZlibWithDictionary() {
   var dict = [102, 111, 111, 98, 97, 114];
   var data = [98, 97, 114, 102, 111, 111];
@@ -380,6 +460,10 @@ void main() {
   testZlibInflateThrowsWithSmallerWindow();
   testZlibInflateWithLargerWindow();
   testRoundTripLarge();
+  testRoundTripLargeParallel();
+  testParallelMatchesSerial();
+  testParallelFlush();
+  testParallelInvalidThreads();
   testZlibWithDictionary();
   testConcatenatedBlocksGZip();
   testConcatenatedBlocksZLib();